@@ -0,0 +1,154 @@
+#include "Alloc.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+
+namespace Alloc
+{
+	static thread_local uint64_t threadAllocations = 0;
+	static thread_local uint64_t threadBytes = 0;
+	static thread_local int64_t threadLiveBytes = 0;
+	static thread_local int64_t threadPeakLiveBytes = 0;
+
+	Scope::Scope()
+		: startAllocations(threadAllocations)
+		, startBytes(threadBytes)
+		, startLiveBytes(threadLiveBytes)
+		, outerPeakLiveBytes(threadPeakLiveBytes)
+	{
+		threadPeakLiveBytes = threadLiveBytes;
+	}
+
+	Counts Scope::finish()
+	{
+		Counts counts;
+		counts.allocations = threadAllocations - startAllocations;
+		counts.bytes = threadBytes - startBytes;
+		counts.peakLiveBytes = (uint64_t) std::max<int64_t>(0, threadPeakLiveBytes - startLiveBytes);
+
+		threadPeakLiveBytes = std::max(threadPeakLiveBytes, outerPeakLiveBytes);
+		return counts;
+	}
+
+	void Handoff::add(const Handoff& later)
+	{
+		counts.allocations += later.counts.allocations;
+		counts.bytes += later.counts.bytes;
+		counts.peakLiveBytes = (uint64_t) std::max<int64_t>((int64_t) counts.peakLiveBytes, liveBytes + (int64_t) later.counts.peakLiveBytes);
+		liveBytes += later.liveBytes;
+	}
+
+	HandoffScope::HandoffScope()
+		: startLiveBytes(threadLiveBytes)
+		, outerPeakLiveBytes(threadPeakLiveBytes)
+	{
+	}
+
+	Handoff HandoffScope::finish()
+	{
+		Handoff handoff;
+		handoff.counts = scope.finish();
+		handoff.liveBytes = threadLiveBytes - startLiveBytes;
+
+		threadAllocations -= handoff.counts.allocations;
+		threadBytes -= handoff.counts.bytes;
+		threadLiveBytes = startLiveBytes;
+		threadPeakLiveBytes = outerPeakLiveBytes;
+		return handoff;
+	}
+
+	void receive(const Handoff& handoff)
+	{
+		threadAllocations += handoff.counts.allocations;
+		threadBytes += handoff.counts.bytes;
+		threadPeakLiveBytes = std::max<int64_t>(threadPeakLiveBytes, threadLiveBytes + (int64_t) handoff.counts.peakLiveBytes);
+		threadLiveBytes += handoff.liveBytes;
+	}
+
+	std::ostream& operator<<(std::ostream& out, const Counts& counts)
+	{
+		return out << counts.allocations << " allocs, " << counts.bytes << " bytes, peak " << counts.peakLiveBytes << " bytes";
+	}
+
+#ifdef AOC_ALLOC_STATS
+	// Every block carries its size (and its distance from what malloc returned,
+	// for over-aligned types) just in front of the pointer handed out.
+	struct Header
+	{
+		size_t size;
+		size_t offset;
+	};
+
+	static_assert(sizeof(Header) <= alignof(std::max_align_t));
+
+	static void* allocate(size_t size, size_t alignment)
+	{
+		alignment = std::max(alignment, alignof(std::max_align_t));
+
+		const size_t padding = alignment > alignof(std::max_align_t) ? alignment : 0;
+		char* raw = static_cast<char*>(std::malloc(size + alignof(std::max_align_t) + padding));
+		if (!raw)
+			return nullptr;
+
+		const uintptr_t unaligned = reinterpret_cast<uintptr_t>(raw) + sizeof(Header);
+		char* user = reinterpret_cast<char*>((unaligned + alignment - 1) & ~(uintptr_t) (alignment - 1));
+
+		Header* header = reinterpret_cast<Header*>(user) - 1;
+		header->size = size;
+		header->offset = (size_t) (user - raw);
+
+		++threadAllocations;
+		threadBytes += size;
+		threadLiveBytes += (int64_t) size;
+		threadPeakLiveBytes = std::max(threadPeakLiveBytes, threadLiveBytes);
+
+		return user;
+	}
+
+	static void deallocate(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		const Header* header = static_cast<Header*>(ptr) - 1;
+		threadLiveBytes -= (int64_t) header->size;
+
+		std::free(static_cast<char*>(ptr) - header->offset);
+	}
+
+	static void* allocateOrThrow(size_t size, size_t alignment)
+	{
+		if (void* ptr = allocate(size, alignment))
+			return ptr;
+
+		throw std::bad_alloc();
+	}
+#endif
+}
+
+#ifdef AOC_ALLOC_STATS
+void* operator new(size_t size) { return Alloc::allocateOrThrow(size, 0); }
+void* operator new[](size_t size) { return Alloc::allocateOrThrow(size, 0); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return Alloc::allocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return Alloc::allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) { return Alloc::allocateOrThrow(size, (size_t) alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return Alloc::allocateOrThrow(size, (size_t) alignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return Alloc::allocate(size, (size_t) alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return Alloc::allocate(size, (size_t) alignment); }
+
+void operator delete(void* ptr) noexcept { Alloc::deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { Alloc::deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { Alloc::deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { Alloc::deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { Alloc::deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { Alloc::deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { Alloc::deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { Alloc::deallocate(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { Alloc::deallocate(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { Alloc::deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { Alloc::deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { Alloc::deallocate(ptr); }
+#endif
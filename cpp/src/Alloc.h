@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+
+// Heap allocation accounting. Builds with AOC_ALLOC_STATS defined replace the
+// global operator new/delete (see Alloc.cpp) so that every allocation made on
+// a thread is counted, and the harness reports the counts for each load/part
+// phase. Without it, tracking is compiled out and all counts read zero.
+
+namespace Alloc
+{
+#ifdef AOC_ALLOC_STATS
+	constexpr bool isTracking = true;
+#else
+	constexpr bool isTracking = false;
+#endif
+
+	struct Counts
+	{
+		uint64_t allocations = 0;
+		uint64_t bytes = 0;
+		uint64_t peakLiveBytes = 0; // high-water mark above the live bytes at the start of the scope
+	};
+
+	// Measures allocations made by this thread between construction and
+	// finish(). Scopes nest. Memory freed by a different thread than the one
+	// that allocated it is credited to the freeing thread.
+	class Scope
+	{
+	public:
+		Scope();
+		Counts finish();
+
+	private:
+		uint64_t startAllocations = 0;
+		uint64_t startBytes = 0;
+		int64_t startLiveBytes = 0;
+		int64_t outerPeakLiveBytes = 0;
+	};
+
+	// What a thread allocated while working for another, such as a Parallel
+	// chunk: measured by a HandoffScope on the thread that did the work, which
+	// takes it off that thread's counts, and added to the counts of the thread
+	// it was done for by receive().
+	struct Handoff
+	{
+		Counts counts;
+		int64_t liveBytes = 0; // still allocated at the end
+
+		// Adds later's allocations as though they were made after these.
+		void add(const Handoff& later);
+	};
+
+	class HandoffScope
+	{
+	public:
+		HandoffScope();
+		Handoff finish();
+
+	private:
+		// Before scope, which resets the peak.
+		int64_t startLiveBytes = 0;
+		int64_t outerPeakLiveBytes = 0;
+		Scope scope;
+	};
+
+	void receive(const Handoff& handoff);
+
+	template <typename Fn>
+	decltype(auto) track(Counts& counts, Fn&& fn)
+	{
+		if constexpr (isTracking)
+		{
+			Scope scope;
+			decltype(auto) result = fn();
+			counts = scope.finish();
+			return result;
+		}
+		else
+		{
+			return fn();
+		}
+	}
+
+	std::ostream& operator<<(std::ostream& out, const Counts& counts);
+}
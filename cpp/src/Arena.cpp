@@ -0,0 +1,26 @@
+#include "Arena.h"
+
+#include <cassert>
+
+static thread_local Arena* currentArena = nullptr;
+
+Arena::Arena(size_t initialSize)
+	: initialBlock(new std::byte[initialSize])
+	, buffer(initialBlock.get(), initialSize)
+	, outer(currentArena)
+{
+	currentArena = this;
+}
+
+Arena::~Arena()
+{
+	// Arenas are scopes, so they have to go in the reverse of the order they
+	// were made.
+	assert(currentArena == this);
+	currentArena = outer;
+}
+
+std::pmr::memory_resource* Arena::current()
+{
+	return currentArena ? currentArena->getResource() : std::pmr::get_default_resource();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+// Scratch memory for a phase of a solver. An Arena is a monotonic buffer:
+// allocating from it just bumps a pointer, freeing does nothing, and reset()
+// (or destroying the arena) hands everything back at once. While it is alive
+// it is installed as this thread's current arena, so std::pmr containers can
+// be built on whichever arena the caller set up:
+//
+//     Arena arena;
+//     for (...)
+//     {
+//         std::pmr::set<Entity*> pushed(Arena::current());
+//         ...
+//         arena.reset(); // once pushed is gone
+//     }
+//
+// The first block is kept across resets, so a loop whose scratch fits in it
+// never goes back to the heap. Arenas nest; they are not shared between
+// threads, so a parallel loop that wants one sets it up in each chunk.
+
+class Arena
+{
+public:
+	static constexpr size_t defaultInitialSize = 64 * 1024;
+
+	explicit Arena(size_t initialSize = defaultInitialSize);
+	~Arena();
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	std::pmr::memory_resource* getResource() { return &buffer; }
+
+	// Frees everything allocated from the arena. Nothing built on it may be
+	// used afterwards.
+	void reset() { buffer.release(); }
+
+	// The innermost arena alive on this thread, or the ordinary heap if none.
+	static std::pmr::memory_resource* current();
+
+private:
+	std::unique_ptr<std::byte[]> initialBlock;
+	std::pmr::monotonic_buffer_resource buffer;
+	Arena* outer = nullptr;
+};
@@ -0,0 +1,160 @@
+#include "Batch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Days.h"
+#include "Parallel.h"
+#include "Service.h"
+#include "String.h"
+
+namespace Batch
+{
+	static std::vector<std::filesystem::path> findInputs(const std::filesystem::path& inputs)
+	{
+		std::vector<std::filesystem::path> files;
+		std::error_code error;
+
+		if (std::filesystem::is_directory(inputs, error))
+		{
+			for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(inputs, error))
+				if (entry.is_regular_file(error))
+					files.push_back(entry.path());
+
+			std::sort(files.begin(), files.end());
+		}
+		else if (std::filesystem::is_regular_file(inputs, error))
+		{
+			for (std::string_view line : String::Lines(inputs.string().c_str()))
+				if (!line.empty())
+					files.push_back(inputs.parent_path() / line);
+		}
+
+		return files;
+	}
+
+	bool run(int day, const char* inputs)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		const Days::Day* registered = Days::find(day);
+		if (!registered || !registered->solver)
+		{
+			std::cerr << "Day " << day << " has no solver to run a batch with" << std::endl;
+			return false;
+		}
+
+		const std::vector<std::filesystem::path> files = findInputs(inputs);
+		if (files.empty())
+		{
+			std::cerr << "No inputs found in " << inputs << std::endl;
+			return false;
+		}
+
+		enum class Status
+		{
+			Solved,
+			Missing,
+			Failed,
+		};
+
+		struct Result
+		{
+			Status status = Status::Solved;
+			double seconds = 0.0;
+		};
+
+		// The files already fill the pool, so each only gets threads of its
+		// own when there are fewer files than threads.
+		const unsigned threadsPerFile = std::max<unsigned>(1, Parallel::getThreadCount() / (unsigned) std::min<size_t>(files.size(), Parallel::getThreadCount()));
+
+		std::vector<Result> results(files.size());
+		std::mutex printMutex;
+		const Clock::time_point start = Clock::now();
+
+		// Each file is solved in its own process and printed as soon as it's
+		// done, so an input that trips the day's asserts fails only itself
+		// and the files solved before it still show.
+		Parallel::forEach(0, files.size(), [&] (size_t i)
+		{
+			Result& result = results[i];
+			std::string output;
+			std::string failure;
+
+			std::error_code error;
+			if (!std::filesystem::is_regular_file(files[i], error))
+			{
+				result.status = Status::Missing;
+			}
+			else
+			{
+				const Clock::time_point fileStart = Clock::now();
+				failure = Service::solveContained(*registered, files[i].string(), output, threadsPerFile);
+				result.seconds = std::chrono::duration<double>(Clock::now() - fileStart).count();
+
+				if (!failure.empty())
+					result.status = Status::Failed;
+			}
+
+			std::lock_guard lock(printMutex);
+			std::cout << "=== " << files[i].string() << " ===\n";
+
+			switch (result.status)
+			{
+			case Status::Solved: std::cout << output << "Took " << result.seconds << "s" << std::endl; break;
+			case Status::Missing: std::cout << "No such file" << std::endl; break;
+			case Status::Failed: std::cout << "Error: " << failure << std::endl; break;
+			}
+		});
+
+		const double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		double totalSeconds = 0.0;
+		size_t slowest = files.size();
+		size_t numMissing = 0;
+		size_t numFailed = 0;
+
+		for (size_t i = 0; i < files.size(); ++i)
+		{
+			const Result& result = results[i];
+
+			if (result.status == Status::Missing)
+			{
+				++numMissing;
+				continue;
+			}
+
+			if (result.status == Status::Failed)
+			{
+				++numFailed;
+				continue;
+			}
+
+			totalSeconds += result.seconds;
+			if (slowest == files.size() || result.seconds > results[slowest].seconds)
+				slowest = i;
+		}
+
+		const size_t numSolved = files.size() - numMissing - numFailed;
+
+		std::cout << "\n--- Batch (day " << day << ", " << numSolved << " inputs, " << Parallel::getThreadCount() << " threads) ---\n";
+		if (numMissing > 0)
+			std::cout << "Missing:   " << numMissing << " inputs\n";
+		if (numFailed > 0)
+			std::cout << "Failed:    " << numFailed << " inputs\n";
+		if (numSolved > 0)
+		{
+			std::cout << "Mean:      " << totalSeconds / numSolved << "s per input\n";
+			std::cout << "Slowest:   " << results[slowest].seconds << "s (" << files[slowest].string() << ")\n";
+		}
+		std::cout << "Total:     " << totalSeconds << "s\n";
+		std::cout << "Wall time: " << wallSeconds << "s" << std::endl;
+
+		return numMissing == 0 && numFailed == 0;
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// Solves one day over many inputs at once, for workloads that are lots of
+// different puzzle inputs rather than one. The files are spread across the
+// Parallel pool and each is solved in its own process (see
+// Service::solveContained), so one bad input fails only itself. Each file's
+// output is printed as soon as it is done, followed by totals for the batch.
+
+namespace Batch
+{
+	// inputs is either a directory, whose regular files are all solved, or a
+	// manifest listing one input per line (relative to the manifest's own
+	// directory). False if the day has no solver, there were no inputs, or
+	// any listed input was missing or failed to solve.
+	bool run(int day, const char* inputs);
+}
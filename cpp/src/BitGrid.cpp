@@ -0,0 +1,208 @@
+#include "BitGrid.h"
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <utility>
+
+BitGrid::BitGrid(int width, int height, bool value)
+	: width(width)
+	, height(height)
+	, wordsPerRow((width + bitsPerWord - 1) / bitsPerWord)
+	, words((size_t) wordsPerRow * height, 0)
+{
+	assert(width >= 0 && height >= 0);
+	fill(value);
+}
+
+BitGrid::Word BitGrid::getShiftedWord(int y, int word, int dx) const
+{
+	assert(-bitsPerWord < dx && dx < bitsPerWord);
+
+	if (y < 0 || y >= height)
+		return 0;
+
+	const Word* row = &words[(size_t) y * wordsPerRow];
+	Word shifted = row[word];
+
+	if (dx > 0)
+	{
+		shifted <<= dx;
+		if (word > 0)
+			shifted |= row[word - 1] >> (bitsPerWord - dx);
+	}
+	else if (dx < 0)
+	{
+		shifted >>= -dx;
+		if (word + 1 < wordsPerRow)
+			shifted |= row[word + 1] << (bitsPerWord + dx);
+	}
+
+	return shifted & getMask(word);
+}
+
+void BitGrid::fill(bool value)
+{
+	for (int y = 0; y < height; ++y)
+		for (int word = 0; word < wordsPerRow; ++word)
+			setWord(y, word, value ? ~Word(0) : 0);
+}
+
+bool BitGrid::any() const
+{
+	return std::any_of(words.begin(), words.end(), [] (Word word) { return word != 0; });
+}
+
+size_t BitGrid::count() const
+{
+	size_t total = 0;
+	for (const Word word : words)
+		total += std::popcount(word);
+
+	return total;
+}
+
+BitGrid& BitGrid::operator&=(const BitGrid& other)
+{
+	assert(width == other.width && height == other.height);
+	for (size_t i = 0; i < words.size(); ++i)
+		words[i] &= other.words[i];
+
+	return *this;
+}
+
+BitGrid& BitGrid::operator|=(const BitGrid& other)
+{
+	assert(width == other.width && height == other.height);
+	for (size_t i = 0; i < words.size(); ++i)
+		words[i] |= other.words[i];
+
+	return *this;
+}
+
+BitGrid& BitGrid::andNot(const BitGrid& other)
+{
+	assert(width == other.width && height == other.height);
+	for (size_t i = 0; i < words.size(); ++i)
+		words[i] &= ~other.words[i];
+
+	return *this;
+}
+
+void BitGrid::andShifted(const BitGrid& other, Vec2 offset)
+{
+	assert(width == other.width && height == other.height);
+	for (int y = 0; y < height; ++y)
+		for (int word = 0; word < wordsPerRow; ++word)
+			words[getIndex(y, word)] &= other.getShiftedWord(y - offset.y, word, offset.x);
+}
+
+void BitGrid::orShifted(const BitGrid& other, Vec2 offset)
+{
+	assert(width == other.width && height == other.height);
+	for (int y = 0; y < height; ++y)
+		for (int word = 0; word < wordsPerRow; ++word)
+			words[getIndex(y, word)] |= other.getShiftedWord(y - offset.y, word, offset.x);
+}
+
+BitSearch::BitSearch(const BitGrid& walls, Vec2 start)
+	: walls(walls)
+	, reached(walls.getWidth(), walls.getHeight())
+	, wave(walls.getWidth(), walls.getHeight())
+	, next(walls.getWidth(), walls.getHeight())
+	, waveSpans(walls.getHeight())
+	, nextSpans(walls.getHeight())
+{
+	if (!walls.isInBounds(start) || walls[start])
+		return;
+
+	reached.set(start);
+	wave.set(start);
+
+	const int word = start.x / BitGrid::bitsPerWord;
+	waveSpans[start.y] = {word, word};
+	firstRow = lastRow = start.y;
+}
+
+bool BitSearch::step()
+{
+	using Word = BitGrid::Word;
+
+	if (firstRow > lastRow)
+		return false;
+
+	const int height = walls.getHeight();
+	const int lastWord = walls.getWordsPerRow() - 1;
+
+	int nextFirstRow = INT_MAX;
+	int nextLastRow = -1;
+
+	for (int y = std::max(firstRow - 1, 0); y <= std::min(lastRow + 1, height - 1); ++y)
+	{
+		// The words next to the wave in this row and the ones either side.
+		Span span = {INT_MAX, -1};
+		for (int from = std::max(y - 1, firstRow); from <= std::min(y + 1, lastRow); ++from)
+		{
+			if (waveSpans[from].first > waveSpans[from].last)
+				continue;
+
+			span.first = std::min(span.first, std::max(waveSpans[from].first - 1, 0));
+			span.last = std::max(span.last, std::min(waveSpans[from].last + 1, lastWord));
+		}
+
+		Span found = {INT_MAX, -1};
+		for (int word = span.first; word <= span.last; ++word)
+		{
+			const Word neighbours = wave.getShiftedWord(y, word, 1)
+				| wave.getShiftedWord(y, word, -1)
+				| wave.getShiftedWord(y - 1, word, 0)
+				| wave.getShiftedWord(y + 1, word, 0);
+
+			const Word cells = neighbours & ~walls.getWord(y, word) & ~reached.getWord(y, word);
+			if (!cells)
+				continue;
+
+			next.setWord(y, word, cells);
+			reached.setWord(y, word, reached.getWord(y, word) | cells);
+			found.first = std::min(found.first, word);
+			found.last = word;
+		}
+
+		if (found.first <= found.last)
+		{
+			nextSpans[y] = found;
+			nextFirstRow = std::min(nextFirstRow, y);
+			nextLastRow = y;
+		}
+	}
+
+	// Clear the old wave so that it can take the one after next.
+	for (int y = firstRow; y <= lastRow; ++y)
+	{
+		for (int word = waveSpans[y].first; word <= waveSpans[y].last; ++word)
+			wave.setWord(y, word, 0);
+
+		waveSpans[y] = {};
+	}
+
+	std::swap(wave, next);
+	std::swap(waveSpans, nextSpans);
+	firstRow = nextFirstRow;
+	lastRow = nextLastRow;
+	++distance;
+
+	return firstRow <= lastRow;
+}
+
+std::optional<int> BitSearch::findDistance(Vec2 target)
+{
+	assert(walls.isInBounds(target));
+
+	while (!reached[target])
+	{
+		if (!step())
+			return std::nullopt;
+	}
+
+	return distance;
+}
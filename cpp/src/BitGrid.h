@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Vec2.h"
+
+// A grid of one-bit cells, 64 to a word with each row starting a new word,
+// for wall and obstacle maps. Besides reading and writing single cells it
+// hands out 64 cells at a time, and whole grids can be combined with AND, OR
+// and AND NOT, directly or with a copy of another grid shifted by an offset.
+// Bits past the width are always clear.
+
+class BitGrid
+{
+public:
+	using Word = uint64_t;
+	static constexpr int bitsPerWord = 64;
+
+	BitGrid() = default;
+	BitGrid(int width, int height, bool value = false);
+
+	int getWidth() const { return width; }
+	int getHeight() const { return height; }
+	int getWordsPerRow() const { return wordsPerRow; }
+
+	EZBounds getBounds() const { return {width, height}; }
+	bool isInBounds(Vec2 pos) const { return getBounds().isInBounds(pos); }
+
+	bool operator[](Vec2 pos) const
+	{
+		return (getWord(pos.y, pos.x / bitsPerWord) >> (pos.x % bitsPerWord)) & 1;
+	}
+
+	void set(Vec2 pos, bool value = true)
+	{
+		assert(isInBounds(pos));
+		Word& word = words[getIndex(pos.y, pos.x / bitsPerWord)];
+		const Word bit = Word(1) << (pos.x % bitsPerWord);
+		word = value ? (word | bit) : (word & ~bit);
+	}
+
+	// The cells x = word * 64 onwards of row y, the first in the lowest bit.
+	Word getWord(int y, int word) const { return words[getIndex(y, word)]; }
+	void setWord(int y, int word, Word value) { words[getIndex(y, word)] = value & getMask(word); }
+
+	// The same word after the whole grid has moved dx cells along x: the
+	// cells come from x - dx. Cells from outside the grid, including rows
+	// above or below it, are clear.
+	Word getShiftedWord(int y, int word, int dx) const;
+
+	void fill(bool value);
+	bool any() const;
+	size_t count() const;
+
+	BitGrid& operator&=(const BitGrid& other);
+	BitGrid& operator|=(const BitGrid& other);
+	BitGrid& andNot(const BitGrid& other);
+
+	// Combine with other moved by offset, as if each cell of other at pos were
+	// at pos + offset. offset.x must be within a word either way.
+	void andShifted(const BitGrid& other, Vec2 offset);
+	void orShifted(const BitGrid& other, Vec2 offset);
+
+	bool operator==(const BitGrid& other) const = default;
+
+private:
+	size_t getIndex(int y, int word) const
+	{
+		assert(0 <= y && y < height && 0 <= word && word < wordsPerRow);
+		return (size_t) y * wordsPerRow + word;
+	}
+
+	// The cells of the word that are inside the grid.
+	Word getMask(int word) const
+	{
+		const int used = width - word * bitsPerWord;
+		return used >= bitsPerWord ? ~Word(0) : (Word(1) << used) - 1;
+	}
+
+	int width = 0;
+	int height = 0;
+	int wordsPerRow = 0;
+	std::vector<Word> words;
+};
+
+// Breadth-first search over the cells that are clear in walls, a wave at a
+// time: each step finds every cell one step further from the start at once,
+// 64 cells per operation. Only the words within a word of the last wave are
+// visited, so a step costs about as much as the wave is long, not the grid.
+class BitSearch
+{
+public:
+	BitSearch(const BitGrid& walls, Vec2 start);
+
+	// Moves on to the cells one step further. False once there are none.
+	bool step();
+
+	// Steps until target is reached, then how many steps it took from the
+	// start, or nothing if it can't be reached.
+	std::optional<int> findDistance(Vec2 target);
+
+	int getDistance() const { return distance; } // of the current wave
+	const BitGrid& getWave() const { return wave; }
+	const BitGrid& getReached() const { return reached; }
+
+private:
+	// The words of a row that the wave might occupy, none when first > last.
+	struct Span
+	{
+		int first = 0;
+		int last = -1;
+	};
+
+	const BitGrid& walls;
+	BitGrid reached;
+	BitGrid wave;
+	BitGrid next;
+	std::vector<Span> waveSpans;
+	std::vector<Span> nextSpans;
+	int firstRow = 0; // of the wave
+	int lastRow = -1;
+	int distance = 0;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Priority queues for searches, popping the lowest priority first, with the
+// same push(priority, value) / pop() interface so a search can take either.
+//
+// BucketQueue is Dial's queue for small integer priorities that never go
+// down: one bucket per priority in a circular array, so both push and pop
+// are O(1) amortised. It only needs as many buckets as the biggest step up
+// from the priority last popped to one pushed, which for Dijkstra is the
+// most expensive edge. Priorities count up from the first one pushed, so
+// they can start anywhere, such as at A*'s estimate for the start. Equal
+// priorities pop in no particular order.
+
+template <typename T, typename Priority>
+class BucketQueue
+{
+public:
+	explicit BucketQueue(Priority maxStep)
+		: buckets((size_t) maxStep + 1)
+	{
+	}
+
+	bool empty() const { return count == 0; }
+	size_t size() const { return count; }
+
+	void push(Priority priority, const T& value)
+	{
+		if (!started)
+		{
+			current = priority;
+			started = true;
+		}
+
+		assert(priority >= current && (size_t) (priority - current) < buckets.size());
+		buckets[(size_t) priority % buckets.size()].push_back(value);
+		++count;
+	}
+
+	std::pair<Priority, T> pop()
+	{
+		assert(!empty());
+
+		std::vector<T>* bucket = &buckets[(size_t) current % buckets.size()];
+		while (bucket->empty())
+			bucket = &buckets[(size_t) ++current % buckets.size()];
+
+		std::pair<Priority, T> top = {current, std::move(bucket->back())};
+		bucket->pop_back();
+		--count;
+		return top;
+	}
+
+private:
+	std::vector<std::vector<T>> buckets;
+	Priority current = 0;
+	size_t count = 0;
+	bool started = false;
+};
+
+// A binary heap for when priorities are spread too widely for buckets.
+template <typename T, typename Priority>
+class HeapQueue
+{
+public:
+	bool empty() const { return heap.empty(); }
+	size_t size() const { return heap.size(); }
+
+	void push(Priority priority, const T& value)
+	{
+		heap.push({priority, value});
+	}
+
+	std::pair<Priority, T> pop()
+	{
+		assert(!empty());
+
+		std::pair<Priority, T> top = {heap.top().priority, heap.top().value};
+		heap.pop();
+		return top;
+	}
+
+private:
+	struct Item
+	{
+		Priority priority;
+		T value;
+
+		bool operator>(const Item& r) const { return priority > r.priority; }
+	};
+
+	std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+};
@@ -0,0 +1,131 @@
+#include "Cache.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+
+namespace Cache
+{
+	static std::atomic<bool> enabled = false;
+
+	// Bumped whenever the header or the encoding of the standard types changes.
+	static constexpr uint32_t formatVersion = 1;
+	static constexpr char magic[4] = {'A', 'O', 'C', 'C'};
+
+	void setEnabled(bool value)
+	{
+		enabled = value;
+	}
+
+	bool isEnabled()
+	{
+		return enabled;
+	}
+
+	void Archive::bytes(void* data, size_t size)
+	{
+		if (size == 0)
+			return;
+
+		if (!isLoading())
+		{
+			output->append(static_cast<const char*>(data), size);
+		}
+		else if (failed || size > (size_t) (end - cursor))
+		{
+			failed = true;
+			std::memset(data, 0, size);
+		}
+		else
+		{
+			std::memcpy(data, cursor, size);
+			cursor += size;
+		}
+	}
+
+	void Archive::value(std::string& str)
+	{
+		if (isDescribing())
+			describe("string;");
+		else if (resize(str))
+			bytes(str.data(), str.size());
+	}
+
+	void Archive::value(std::vector<bool>& v)
+	{
+		if (isDescribing())
+		{
+			describe("vector<bool>;");
+			return;
+		}
+
+		if (!resize(v))
+			return;
+
+		for (size_t i = 0; i < v.size(); ++i)
+		{
+			uint8_t bit = v[i];
+			value(bit);
+			v[i] = bit != 0;
+		}
+	}
+
+	uint64_t hash(const char* data, size_t size)
+	{
+		// 64-bit FNV-1a.
+		uint64_t h = 0xcbf29ce484222325ull;
+		for (size_t i = 0; i < size; ++i)
+		{
+			h ^= (uint8_t) data[i];
+			h *= 0x100000001b3ull;
+		}
+		return h;
+	}
+
+	std::string getCacheFilename(const char* inputFilename)
+	{
+		return std::string(inputFilename) + ".cache";
+	}
+
+	void writeHeader(Archive& archive, const Key& key)
+	{
+		char fileMagic[4] = {magic[0], magic[1], magic[2], magic[3]};
+		uint32_t version = formatVersion;
+		Key fileKey = key;
+		archive(fileMagic, version, fileKey);
+	}
+
+	bool readHeader(Archive& archive, const Key& key)
+	{
+		char fileMagic[4] = {};
+		uint32_t version = 0;
+		Key fileKey;
+		archive(fileMagic, version, fileKey);
+
+		return archive.ok()
+			&& std::memcmp(fileMagic, magic, sizeof(magic)) == 0
+			&& version == formatVersion
+			&& fileKey.inputHash == key.inputHash
+			&& fileKey.inputSize == key.inputSize
+			&& fileKey.typeHash == key.typeHash;
+	}
+
+	void writeFile(const std::string& filename, const std::string& bytes)
+	{
+		const std::string temporary = filename + ".tmp";
+		{
+			std::ofstream s{ temporary, s.out | s.binary | s.trunc };
+			if (!s.is_open())
+				return;
+
+			s.write(bytes.data(), (std::streamsize) bytes.size());
+			if (!s.good())
+				return;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporary, filename, error);
+		if (error)
+			std::filesystem::remove(temporary, error);
+	}
+}
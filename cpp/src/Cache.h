@@ -0,0 +1,327 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "MappedFile.h"
+
+// Binary cache of parsed input. With --cache, a day's loaded data is written
+// to <input>.cache after the first parse, keyed by a hash of the input text,
+// and read back from a mapping of that file on later runs instead of parsing
+// the text again.
+//
+// A day opts in by giving its data type a field list next to its definition:
+//
+//     static void serialize(Cache::Archive& archive, Data01& data)
+//     {
+//         archive(data.leftList, data.rightList);
+//     }
+//
+// Arithmetic types, enums and other trivially copyable structs (Vec2,
+// Bounds, ...) are stored as raw bytes, as are vectors of them; strings,
+// vectors, maps, sets and pairs of anything serializable are handled too.
+//
+// The cache is native-endian and tied to the build that wrote it. Its key
+// includes a hash of the data type's schema: the field lists its serialize
+// functions give, all the way down, with the type and size of every raw
+// field. Adding, removing or retyping a field, or changing a raw struct's
+// layout, means the input is parsed again. What isn't caught is a change
+// that keeps every field's type, such as swapping two fields of the same
+// type or filling one differently; bump formatVersion in Cache.cpp for
+// those. Field lists are described from default-constructed values, so
+// types can't contain themselves.
+
+namespace Cache
+{
+	class Archive;
+
+	template <typename T>
+	concept HasSerialize = requires (Archive& archive, T& value) { serialize(archive, value); };
+
+	template <typename T>
+	concept IsRaw = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !HasSerialize<T>;
+
+	// One class for both directions so that each day lists its fields once.
+	class Archive
+	{
+	public:
+		struct Describe {};
+
+		explicit Archive(std::string& output) : output(&output) {}
+		Archive(const char* data, size_t size) : cursor(data), end(data + size) {}
+
+		// Writes nothing but the schema of the values it is given.
+		Archive(Describe, std::string& schema) : schema(&schema) {}
+
+		bool isLoading() const { return output == nullptr && schema == nullptr; }
+		bool isDescribing() const { return schema != nullptr; }
+
+		// False once a load has run past the end of the data.
+		bool ok() const { return !failed; }
+		bool atEnd() const { return cursor == end; }
+
+		template <typename... Ts>
+		void operator()(Ts&... values)
+		{
+			(value(values), ...);
+		}
+
+		void bytes(void* data, size_t size);
+
+		template <typename T>
+		void value(T& v)
+		{
+			static_assert(HasSerialize<T> || IsRaw<T>, "Give the type a serialize(Cache::Archive&, T&) function");
+
+			if constexpr (HasSerialize<T>)
+			{
+				describe("{");
+				serialize(*this, v);
+				describe("}");
+			}
+			else if (isDescribing())
+			{
+				describeRaw<T>();
+			}
+			else
+			{
+				bytes(&v, sizeof(T));
+			}
+		}
+
+		void value(std::string& str);
+		void value(std::vector<bool>& v);
+
+		template <typename T, typename Alloc>
+		void value(std::vector<T, Alloc>& v)
+		{
+			if (isDescribing())
+			{
+				describeElements<T>("vector");
+				return;
+			}
+
+			if (!resize(v))
+				return;
+
+			if constexpr (IsRaw<T>)
+				bytes(v.data(), v.size() * sizeof(T));
+			else
+				for (T& element : v)
+					value(element);
+		}
+
+		template <typename A, typename B>
+		void value(std::pair<A, B>& p)
+		{
+			value(p.first);
+			value(p.second);
+		}
+
+		template <typename K, typename V, typename Compare, typename Alloc>
+		void value(std::map<K, V, Compare, Alloc>& map)
+		{
+			if (isDescribing())
+			{
+				describeElements<K, V>("map");
+				return;
+			}
+
+			uint64_t count = map.size();
+			value(count);
+
+			if (isLoading())
+			{
+				map.clear();
+				for (uint64_t i = 0; i < count && ok(); ++i)
+				{
+					std::pair<K, V> entry;
+					value(entry);
+					map.emplace_hint(map.end(), std::move(entry));
+				}
+			}
+			else
+			{
+				for (auto& [key, mapped] : map)
+				{
+					K keyCopy = key;
+					value(keyCopy);
+					value(mapped);
+				}
+			}
+		}
+
+		template <typename K, typename Compare, typename Alloc>
+		void value(std::set<K, Compare, Alloc>& set)
+		{
+			if (isDescribing())
+			{
+				describeElements<K>("set");
+				return;
+			}
+
+			uint64_t count = set.size();
+			value(count);
+
+			if (isLoading())
+			{
+				set.clear();
+				for (uint64_t i = 0; i < count && ok(); ++i)
+				{
+					K key;
+					value(key);
+					set.emplace_hint(set.end(), std::move(key));
+				}
+			}
+			else
+			{
+				for (const K& key : set)
+				{
+					K keyCopy = key;
+					value(keyCopy);
+				}
+			}
+		}
+
+	private:
+		void describe(const char* text)
+		{
+			if (isDescribing())
+				schema->append(text);
+		}
+
+		template <typename T>
+		void describeRaw()
+		{
+			schema->append(typeid(T).name());
+			schema->append(":" + std::to_string(sizeof(T)) + ";");
+		}
+
+		// Describes a container by default-constructed elements, since there
+		// may be none to describe it by.
+		template <typename... Elements>
+		void describeElements(const char* container)
+		{
+			describe(container);
+			describe("<");
+			(value(*std::make_unique<Elements>().get()), ...);
+			describe(">");
+		}
+
+		// Stores the container's size or, when loading, resizes it to the
+		// stored one. Returns false if the stored size can't be right.
+		template <typename Container>
+		bool resize(Container& container)
+		{
+			uint64_t count = container.size();
+			value(count);
+
+			if (isLoading())
+			{
+				// Every element takes at least a byte, so a count beyond the
+				// remaining data means the cache is corrupt.
+				if (failed || count > (uint64_t) (end - cursor))
+				{
+					failed = true;
+					return false;
+				}
+				container.resize((size_t) count);
+			}
+			return true;
+		}
+
+		std::string* output = nullptr;
+		std::string* schema = nullptr;
+		const char* cursor = nullptr;
+		const char* end = nullptr;
+		bool failed = false;
+	};
+
+	// Whether a day's data type has opted in to caching.
+	template <typename T>
+	concept Cacheable = HasSerialize<T> || std::is_same_v<T, std::string>;
+
+	void setEnabled(bool enabled);
+	bool isEnabled();
+
+	uint64_t hash(const char* data, size_t size);
+
+	std::string getCacheFilename(const char* inputFilename);
+
+	struct Key
+	{
+		uint64_t inputHash = 0;
+		uint64_t inputSize = 0;
+		uint64_t typeHash = 0;
+	};
+
+	void writeHeader(Archive& archive, const Key& key);
+	bool readHeader(Archive& archive, const Key& key);
+
+	// Writes via a temporary file so a reader never sees half a cache.
+	void writeFile(const std::string& filename, const std::string& bytes);
+
+	// Hashes the schema of Data (see the top of this file).
+	template <typename Data>
+	uint64_t getTypeHash()
+	{
+		static const uint64_t typeHash = []
+		{
+			std::string schema = typeid(Data).name();
+			Archive archive(Archive::Describe(), schema);
+			archive(*std::make_unique<Data>());
+			return hash(schema.data(), schema.size());
+		}();
+
+		return typeHash;
+	}
+
+	// Loads filename's data from its cache if that matches the input text,
+	// otherwise parses it with loadData and (re)writes the cache.
+	template <typename Data, typename LoadFn>
+	Data load(const char* filename, LoadFn&& loadData)
+	{
+		Key key;
+		key.typeHash = getTypeHash<Data>();
+		{
+			const MappedFile input(filename);
+			key.inputHash = hash(input.data(), input.size());
+			key.inputSize = input.size();
+		}
+
+		const std::string cacheFilename = getCacheFilename(filename);
+		{
+			const MappedFile cached(cacheFilename.c_str());
+			if (cached.isOpen())
+			{
+				Archive archive(cached.data(), cached.size());
+				if (readHeader(archive, key))
+				{
+					Data data;
+					archive(data);
+
+					if (archive.ok() && archive.atEnd())
+						return data;
+				}
+			}
+		}
+
+		Data data = loadData(filename);
+
+		std::string bytes;
+		Archive archive(bytes);
+		writeHeader(archive, key);
+		archive(data);
+		writeFile(cacheFilename, bytes);
+
+		return data;
+	}
+}
@@ -0,0 +1,172 @@
+#include "Days.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "Stats.h"
+
+namespace Days
+{
+	static std::vector<Day>& registry()
+	{
+		// Function-local so that registration from other translation units
+		// does not depend on static initialisation order.
+		static std::vector<Day> days;
+		return days;
+	}
+
+	static thread_local std::ostream* currentOut = nullptr;
+	static thread_local int currentNumber = 0;
+
+	Registrar::Registrar(int number, EntryPoint entryPoint, Solver solver, Warmer warmer)
+	{
+		std::vector<Day>& days = registry();
+
+		const auto iter = std::lower_bound(days.begin(), days.end(), number,
+			[] (const Day& day, int n) { return day.number < n; });
+
+		days.insert(iter, Day{number, entryPoint, solver, warmer});
+	}
+
+	const std::vector<Day>& getAll()
+	{
+		return registry();
+	}
+
+	const Day* find(int number)
+	{
+		for (const Day& day : registry())
+			if (day.number == number)
+				return &day;
+
+		return nullptr;
+	}
+
+	std::ostream& out()
+	{
+		return currentOut ? *currentOut : std::cout;
+	}
+
+	int currentDay()
+	{
+		return currentNumber;
+	}
+
+	Scope::Scope(int number, std::ostream& output)
+		: previousNumber(std::exchange(currentNumber, number))
+		, previousOut(std::exchange(currentOut, &output))
+	{
+	}
+
+	Scope::~Scope()
+	{
+		currentNumber = previousNumber;
+		currentOut = previousOut;
+	}
+
+	bool solve(int number, const char* filename)
+	{
+		const Day* day = find(number);
+		if (!day || !day->solver)
+			return false;
+
+		Scope scope(number, out());
+		day->solver(filename);
+		return true;
+	}
+
+	int run(const std::vector<int>& dayNumbers, unsigned threadCount)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		struct Job
+		{
+			const Day* day = nullptr;
+			double seconds = 0.0;
+		};
+
+		std::vector<Job> jobs;
+		int numMissing = 0;
+
+		for (int number : dayNumbers)
+		{
+			if (const Day* day = find(number))
+				jobs.push_back({day});
+			else
+			{
+				std::cerr << "Day " << number << " is not registered" << std::endl;
+				++numMissing;
+			}
+		}
+
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		threadCount = std::min(threadCount, (unsigned) jobs.size());
+
+		// With a single worker there is nothing to interleave with, so let the
+		// day write straight to the console (it may be rendering interactively).
+		const bool bufferOutput = threadCount > 1;
+
+		std::atomic<size_t> nextJob = 0;
+		std::mutex printMutex;
+
+		auto worker = [&] ()
+		{
+			for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+			{
+				Job& job = jobs[i];
+				std::ostringstream buffer;
+				currentOut = bufferOutput ? &buffer : nullptr;
+				currentNumber = job.day->number;
+
+				if (!bufferOutput)
+					std::cout << "=== Day " << job.day->number << " ===" << std::endl;
+
+				const Clock::time_point start = Clock::now();
+				job.day->entryPoint();
+				job.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+				Stats::printSummary(out(), job.day->number, job.seconds);
+
+				currentOut = nullptr;
+				currentNumber = 0;
+
+				std::lock_guard lock(printMutex);
+				if (bufferOutput)
+					std::cout << "=== Day " << job.day->number << " ===\n" << buffer.str();
+				std::cout << "Day " << job.day->number << " took " << job.seconds << "s" << std::endl;
+			}
+		};
+
+		const Clock::time_point start = Clock::now();
+
+		std::vector<std::thread> threads;
+		for (unsigned i = 1; i < threadCount; ++i)
+			threads.emplace_back(worker);
+
+		worker();
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		const double totalSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		if (jobs.size() > 1)
+		{
+			std::cout << "\n--- Summary (" << threadCount << " threads) ---\n";
+			for (const Job& job : jobs)
+				std::cout << "Day " << std::setw(2) << job.day->number << ": " << std::fixed << std::setprecision(3) << job.seconds << "s\n";
+			std::cout << "Wall time: " << totalSeconds << "s" << std::endl;
+		}
+
+		return numMissing;
+	}
+}
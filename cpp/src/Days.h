@@ -0,0 +1,69 @@
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+
+namespace Days
+{
+	using EntryPoint = void (*)();
+
+	// Loads, solves and prints an arbitrary input file without checking the
+	// answers, for inputs that have no known results (see Generators.h).
+	using Solver = void (*)(const char* filename);
+
+	// Fills the day's input-independent tables ahead of the first request in
+	// service mode (see Service.h).
+	using Warmer = void (*)();
+
+	struct Day
+	{
+		int number = 0;
+		EntryPoint entryPoint = nullptr;
+		Solver solver = nullptr;
+		Warmer warmer = nullptr;
+	};
+
+	// Each dayNN.cpp declares one of these at file scope so that the day is
+	// known to the runner without main.cpp having to name it.
+	struct Registrar
+	{
+		Registrar(int number, EntryPoint entryPoint, Solver solver = nullptr, Warmer warmer = nullptr);
+	};
+
+	// All registered days, sorted by day number.
+	const std::vector<Day>& getAll();
+	const Day* find(int number);
+
+	// Where a day should print its results. While the runner executes several
+	// days at once this is a per-day buffer, printed when the day completes.
+	std::ostream& out();
+
+	// Number of the day being run on this thread, or 0 outside the runner.
+	int currentDay();
+
+	// Makes this thread run as the given day, printing to output, until the
+	// scope ends. For threads a day starts itself, so that out(), currentDay()
+	// and the day's stats carry over to them.
+	class Scope
+	{
+	public:
+		Scope(int number, std::ostream& output);
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		int previousNumber = 0;
+		std::ostream* previousOut = nullptr;
+	};
+
+	// Runs the day's solver on filename on this thread, as that day. Returns
+	// false if the day is not registered or has no solver.
+	bool solve(int number, const char* filename);
+
+	// Runs the given days across threadCount threads (0 = one per core) and
+	// prints each day's output along with its wall time. Returns the number of
+	// days that were requested but not registered.
+	int run(const std::vector<int>& dayNumbers, unsigned threadCount);
+}
@@ -0,0 +1,976 @@
+#include "Generators.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <ostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Vec2.h"
+
+namespace Generators
+{
+	// mt19937_64's output is fixed by the standard but the <random>
+	// distributions are not, so ranges and shuffles are done by hand to keep
+	// inputs identical across compilers.
+	using Rng = std::mt19937_64;
+
+	static int64_t uniform(Rng& rng, int64_t lo, int64_t hi)
+	{
+		assert(lo <= hi);
+		return lo + (int64_t) (rng() % (uint64_t) (hi - lo + 1));
+	}
+
+	static bool chance(Rng& rng, int percent)
+	{
+		return uniform(rng, 0, 99) < percent;
+	}
+
+	template <typename T>
+	static void shuffle(std::vector<T>& values, Rng& rng)
+	{
+		for (size_t i = values.size(); i > 1; --i)
+			std::swap(values[i - 1], values[(size_t) uniform(rng, 0, (int64_t) i - 1)]);
+	}
+
+	using CharGrid = std::vector<std::string>;
+
+	static void writeGrid(std::ostream& out, const CharGrid& grid)
+	{
+		for (const std::string& row : grid)
+			out << row << '\n';
+	}
+
+	static bool isInside(const CharGrid& grid, Vec2 pos)
+	{
+		return pos.x >= 0 && pos.y >= 0 && pos.y < (int) grid.size() && pos.x < (int) grid[pos.y].size();
+	}
+
+	// Perfect maze (exactly one route between any two open cells) on a grid
+	// of odd side, with passages on odd coordinates and a solid outer wall.
+	static CharGrid carveMaze(int side, Rng& rng)
+	{
+		assert(side >= 3 && side % 2 == 1);
+
+		CharGrid grid(side, std::string(side, '#'));
+		std::vector<Vec2> stack = {{1, 1}};
+		grid[1][1] = '.';
+
+		while (!stack.empty())
+		{
+			const Vec2 pos = stack.back();
+
+			Vec2 options[4];
+			int numOptions = 0;
+
+			for (const Vec2 dir : Vec2::directions)
+			{
+				const Vec2 next = pos + dir * 2;
+				if (next.x > 0 && next.y > 0 && next.x < side - 1 && next.y < side - 1 && grid[next.y][next.x] == '#')
+					options[numOptions++] = dir;
+			}
+
+			if (numOptions == 0)
+			{
+				stack.pop_back();
+				continue;
+			}
+
+			const Vec2 dir = options[uniform(rng, 0, numOptions - 1)];
+			const Vec2 wall = pos + dir;
+			const Vec2 next = pos + dir * 2;
+			grid[wall.y][wall.x] = '.';
+			grid[next.y][next.x] = '.';
+			stack.push_back(next);
+		}
+
+		return grid;
+	}
+
+	static int oddAtLeast(uint64_t size, int minimum)
+	{
+		const int side = (int) std::max<uint64_t>(size, minimum);
+		return side | 1;
+	}
+
+	// Two columns of five digit location ids. Around half the right-hand ids
+	// repeat a left-hand one so that the similarity score is non-trivial.
+	static void day01(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		std::vector<int64_t> left;
+		left.reserve(size);
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			left.push_back(uniform(rng, 10000, 99999));
+			const int64_t right = chance(rng, 50) ? left[(size_t) uniform(rng, 0, (int64_t) i)] : uniform(rng, 10000, 99999);
+			out << left.back() << "   " << right << '\n';
+		}
+	}
+
+	// Reports of 5 to 8 levels, gently rising or falling, with a bad level
+	// dropped into about half of them.
+	static void day02(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			const int count = (int) uniform(rng, 5, 8);
+			const int sign = chance(rng, 50) ? 1 : -1;
+			const int bad = chance(rng, 50) ? (int) uniform(rng, 0, count - 1) : -1;
+
+			int64_t level = uniform(rng, 30, 70);
+			for (int j = 0; j < count; ++j)
+			{
+				out << (j == 0 ? "" : " ") << level;
+				level += j == bad ? uniform(rng, -4, 4) : sign * uniform(rng, 1, 3);
+			}
+			out << '\n';
+		}
+	}
+
+	// size instructions: real and malformed mul()s, do()s and don't()s
+	// separated by junk, wrapped onto lines of about 3000 characters.
+	static void day03(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		static const char junk[] = "%&!@^*[]<>?:;'{}()-+, fromwhywhereselecthow";
+		std::string line;
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			const int64_t a = uniform(rng, 1, 999);
+			const int64_t b = uniform(rng, 1, 999);
+
+			switch (uniform(rng, 0, 9))
+			{
+			case 0: line += "do()"; break;
+			case 1: line += "don't()"; break;
+			case 2: line += "mul(" + std::to_string(a) + "," + std::to_string(b) + "]"; break;
+			case 3: line += "mul ( " + std::to_string(a) + "," + std::to_string(b) + ")"; break;
+			default: line += "mul(" + std::to_string(a) + "," + std::to_string(b) + ")"; break;
+			}
+
+			for (int64_t j = uniform(rng, 0, 8); j > 0; --j)
+				line += junk[uniform(rng, 0, sizeof(junk) - 2)];
+
+			if (line.size() >= 3000)
+			{
+				out << line << '\n';
+				line.clear();
+			}
+		}
+
+		if (!line.empty() || size == 0)
+			out << line << '\n';
+	}
+
+	static void day04(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		const int side = (int) std::max<uint64_t>(size, 1);
+		for (int y = 0; y < side; ++y)
+		{
+			std::string row(side, ' ');
+			for (char& c : row)
+				c = "XMAS"[uniform(rng, 0, 3)];
+			out << row << '\n';
+		}
+	}
+
+	// A total order over 49 pages, given as every pairwise rule, then size
+	// updates of 5 to 23 pages of which about half are already in order.
+	static void day05(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		std::vector<int> pages;
+		for (int page = 11; page <= 99; ++page)
+			pages.push_back(page);
+
+		shuffle(pages, rng);
+		pages.resize(49);
+
+		std::vector<std::pair<int, int>> rules;
+		for (size_t i = 0; i < pages.size(); ++i)
+			for (size_t j = i + 1; j < pages.size(); ++j)
+				rules.emplace_back(pages[i], pages[j]);
+
+		shuffle(rules, rng);
+		for (const auto& [before, after] : rules)
+			out << before << '|' << after << '\n';
+
+		out << '\n';
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			std::vector<size_t> picked(pages.size());
+			std::iota(picked.begin(), picked.end(), 0);
+			shuffle(picked, rng);
+			picked.resize((size_t) uniform(rng, 2, 11) * 2 + 1);
+
+			if (chance(rng, 50))
+				std::sort(picked.begin(), picked.end());
+
+			for (size_t j = 0; j < picked.size(); ++j)
+				out << (j == 0 ? "" : ",") << pages[picked[j]];
+			out << '\n';
+		}
+	}
+
+	// Square lab with scattered obstacles. Layouts where the guard never
+	// leaves are thrown away, since part one needs the walk to end.
+	static void day06(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		const int side = (int) std::max<uint64_t>(size, 2);
+
+		while (true)
+		{
+			CharGrid grid(side, std::string(side, '.'));
+			for (std::string& row : grid)
+				for (char& c : row)
+					if (chance(rng, 5))
+						c = '#';
+
+			const Vec2 start = {(int) uniform(rng, 0, side - 1), (int) uniform(rng, 0, side - 1)};
+			grid[start.y][start.x] = '^';
+
+			std::vector<uint8_t> seen((size_t) side * side, 0);
+			Vec2 pos = start;
+			int dir = 0;
+			bool exits = false;
+
+			while (true)
+			{
+				uint8_t& state = seen[(size_t) pos.y * side + pos.x];
+				if (state & (1 << dir))
+					break;
+				state |= (uint8_t) (1 << dir);
+
+				const Vec2 next = pos + Vec2::directions[dir];
+				if (!isInside(grid, next))
+				{
+					exits = true;
+					break;
+				}
+
+				if (grid[next.y][next.x] == '#')
+					dir = (dir + 1) % 4;
+				else
+					pos = next;
+			}
+
+			if (exits)
+			{
+				writeGrid(out, grid);
+				return;
+			}
+		}
+	}
+
+	// Equations of 3 to 12 mostly single digit operands, at most 15 digits
+	// between them as in the real inputs: the solver's || goes through
+	// std::stoull, and neither + nor * can outgrow concatenation. Most totals
+	// do come from some mix of the three operators.
+	static void day07(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			const int count = (int) uniform(rng, 3, 12);
+			int digitsLeft = 15;
+
+			std::vector<uint64_t> operands;
+			for (int j = 0; j < count; ++j)
+			{
+				const int64_t roll = uniform(rng, 0, 99);
+				const int digits = std::min<int>(digitsLeft - (count - j - 1), roll < 70 ? 1 : roll < 95 ? 2 : 3);
+				digitsLeft -= digits;
+				operands.push_back((uint64_t) uniform(rng, digits == 1 ? 1 : digits == 2 ? 10 : 100, digits == 1 ? 9 : digits == 2 ? 99 : 999));
+			}
+
+			uint64_t total = operands.front();
+			for (size_t j = 1; j < operands.size(); ++j)
+			{
+				const uint64_t operand = operands[j];
+				switch (uniform(rng, 0, 2))
+				{
+				case 0: total += operand; break;
+				case 1: total *= operand; break;
+				default: total = total * (operand < 10 ? 10 : operand < 100 ? 100 : 1000) + operand; break;
+				}
+			}
+
+			if (chance(rng, 40))
+				total += (uint64_t) uniform(rng, 1, 9);
+
+			out << total << ':';
+			for (const uint64_t operand : operands)
+				out << ' ' << operand;
+			out << '\n';
+		}
+	}
+
+	// About four antennas per frequency, one antenna per 40 cells.
+	static void day08(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		static const char frequencies[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+		const int side = (int) std::max<uint64_t>(size, 1);
+		const int numFrequencies = (int) std::clamp<int64_t>((int64_t) side * side / 160, 1, sizeof(frequencies) - 1);
+
+		CharGrid grid(side, std::string(side, '.'));
+		for (int64_t i = (int64_t) side * side / 40; i > 0; --i)
+			grid[uniform(rng, 0, side - 1)][uniform(rng, 0, side - 1)] = frequencies[uniform(rng, 0, numFrequencies - 1)];
+
+		writeGrid(out, grid);
+	}
+
+	// size digits (made odd so the map ends on a file): files of 1 to 9
+	// blocks, gaps of 0 to 9.
+	static void day09(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		std::string line((size_t) (size | 1), '0');
+		for (size_t i = 0; i < line.size(); ++i)
+			line[i] = (char) ('0' + (i % 2 == 0 ? uniform(rng, 1, 9) : uniform(rng, 0, 9)));
+
+		out << line << '\n';
+	}
+
+	// Random heights with uphill trails from 0 to 9 laid over them, one per
+	// 100 cells. Trails never cross each other, so every trailhead reaches at
+	// least one summit.
+	static void day10(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		const int side = (int) std::max<uint64_t>(size, 1);
+
+		CharGrid grid(side, std::string(side, '0'));
+		for (std::string& row : grid)
+			for (char& c : row)
+				c = (char) ('0' + uniform(rng, 0, 9));
+
+		std::vector<uint8_t> onTrail((size_t) side * side, 0);
+		auto isFree = [&] (Vec2 pos) { return isInside(grid, pos) && !onTrail[(size_t) pos.y * side + pos.x]; };
+
+		for (int64_t i = std::max<int64_t>(1, (int64_t) side * side / 100); i > 0; --i)
+		{
+			std::vector<Vec2> trail = {{(int) uniform(rng, 0, side - 1), (int) uniform(rng, 0, side - 1)}};
+			if (!isFree(trail.back()))
+				continue;
+
+			while (trail.size() < 10)
+			{
+				const int first = (int) uniform(rng, 0, 3);
+				int turn = 0;
+				while (turn < 4 && !isFree(trail.back() + Vec2::directions[(first + turn) % 4]))
+					++turn;
+
+				if (turn == 4)
+					break;
+
+				const Vec2 next = trail.back() + Vec2::directions[(first + turn) % 4];
+				if (std::find(trail.begin(), trail.end(), next) != trail.end())
+					break;
+				trail.push_back(next);
+			}
+
+			if (trail.size() < 10)
+				continue;
+
+			for (int height = 0; height < 10; ++height)
+			{
+				const Vec2 pos = trail[height];
+				grid[pos.y][pos.x] = (char) ('0' + height);
+				onTrail[(size_t) pos.y * side + pos.x] = 1;
+			}
+		}
+
+		writeGrid(out, grid);
+	}
+
+	static void day11(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			static const int64_t limits[] = {9, 99, 999, 9999, 99999, 999999, 9999999};
+			out << (i == 0 ? "" : " ") << uniform(rng, 0, limits[uniform(rng, 0, 6)]);
+		}
+		out << '\n';
+	}
+
+	// Regions grown outwards from one seed per 50 cells, each given a random
+	// letter; neighbouring regions that draw the same letter merge.
+	static void day12(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		const int side = (int) std::max<uint64_t>(size, 1);
+
+		CharGrid grid(side, std::string(side, ' '));
+		std::vector<Vec2> frontier;
+
+		for (int64_t i = std::max<int64_t>(1, (int64_t) side * side / 50); i > 0; --i)
+		{
+			const Vec2 seed = {(int) uniform(rng, 0, side - 1), (int) uniform(rng, 0, side - 1)};
+			if (grid[seed.y][seed.x] == ' ')
+			{
+				grid[seed.y][seed.x] = (char) ('A' + uniform(rng, 0, 25));
+				frontier.push_back(seed);
+			}
+		}
+
+		// Growing from a random frontier cell rather than in BFS order keeps
+		// the region edges ragged.
+		while (!frontier.empty())
+		{
+			const size_t index = (size_t) uniform(rng, 0, (int64_t) frontier.size() - 1);
+			const Vec2 pos = frontier[index];
+			bool grew = false;
+
+			for (int first = (int) uniform(rng, 0, 3), i = 0; i < 4 && !grew; ++i)
+			{
+				const Vec2 next = pos + Vec2::directions[(first + i) % 4];
+				if (isInside(grid, next) && grid[next.y][next.x] == ' ')
+				{
+					grid[next.y][next.x] = grid[pos.y][pos.x];
+					frontier.push_back(next);
+					grew = true;
+				}
+			}
+
+			if (!grew)
+			{
+				frontier[index] = frontier.back();
+				frontier.pop_back();
+			}
+		}
+
+		writeGrid(out, grid);
+	}
+
+	// Claw machines with independent buttons. About a third of the prizes
+	// are reachable within 100 presses of each, and a third are placed so
+	// that they become reachable once part two moves them 10^13 further.
+	static void day13(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		constexpr int64_t offset = 10'000'000'000'000;
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			Vec2i64 a;
+			Vec2i64 b;
+			do
+			{
+				a = {uniform(rng, 10, 99), uniform(rng, 10, 99)};
+				b = {uniform(rng, 10, 99), uniform(rng, 10, 99)};
+			} while (a.x * b.y == a.y * b.x);
+
+			Vec2i64 prize = {uniform(rng, 1000, 20000), uniform(rng, 1000, 20000)};
+			const int64_t roll = uniform(rng, 0, 2);
+
+			if (roll == 0)
+			{
+				prize = a * uniform(rng, 1, 100) + b * uniform(rng, 1, 100);
+			}
+			else if (roll == 1)
+			{
+				// Round the presses that would reach the far prize and move the
+				// prize onto them; it only shifts by a press or so of each button.
+				const double det = (double) (a.x * b.y - a.y * b.x);
+				const int64_t pressesA = std::llround(((prize.x + offset) * (double) b.y - (prize.y + offset) * (double) b.x) / det);
+				const int64_t pressesB = std::llround(((prize.y + offset) * (double) a.x - (prize.x + offset) * (double) a.y) / det);
+				const Vec2i64 moved = a * pressesA + b * pressesB - Vec2i64{offset, offset};
+
+				if (pressesA >= 0 && pressesB >= 0 && moved.x > 0 && moved.y > 0)
+					prize = moved;
+			}
+
+			out << (i == 0 ? "" : "\n")
+				<< "Button A: X+" << a.x << ", Y+" << a.y << '\n'
+				<< "Button B: X+" << b.x << ", Y+" << b.y << '\n'
+				<< "Prize: X=" << prize.x << ", Y=" << prize.y << '\n';
+		}
+	}
+
+	// size robots on the puzzle's 101x103 floor. Ten of them are aimed to
+	// form an unbroken row at one randomly chosen second.
+	static void day14(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		constexpr int width = 101;
+		constexpr int height = 103;
+
+		const int64_t lineTime = uniform(rng, 1, width * height - 1);
+		const Vec2 lineStart = {(int) uniform(rng, 0, width - 11), (int) uniform(rng, 0, height - 1)};
+
+		auto wrap = [] (int64_t value, int64_t range) { return (int) (((value % range) + range) % range); };
+
+		out << width << ',' << height << '\n';
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			const Vec2 vel = {(int) uniform(rng, -100, 100), (int) uniform(rng, -100, 100)};
+			Vec2 pos = {(int) uniform(rng, 0, width - 1), (int) uniform(rng, 0, height - 1)};
+
+			if (size >= 10 && i < 10)
+			{
+				pos.x = wrap(lineStart.x + (int64_t) i - vel.x * lineTime, width);
+				pos.y = wrap(lineStart.y - vel.y * lineTime, height);
+			}
+
+			out << "p=" << pos.x << ',' << pos.y << " v=" << vel.x << ',' << vel.y << '\n';
+		}
+	}
+
+	// Walled warehouse packed a quarter full of boxes, then eight moves per
+	// cell in lines of 1000.
+	static void day15(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		const int side = (int) std::max<uint64_t>(size, 4);
+
+		CharGrid grid(side, std::string(side, '#'));
+		for (int y = 1; y < side - 1; ++y)
+			for (int x = 1; x < side - 1; ++x)
+				grid[y][x] = chance(rng, 25) ? 'O' : chance(rng, 5) ? '#' : '.';
+
+		grid[side / 2][side / 2] = '@';
+		writeGrid(out, grid);
+		out << '\n';
+
+		const uint64_t numMoves = (uint64_t) side * side * 8;
+		std::string line;
+		for (uint64_t i = 0; i < numMoves; ++i)
+		{
+			line += "^>v<"[uniform(rng, 0, 3)];
+			if (line.size() == 1000 || i + 1 == numMoves)
+			{
+				out << line << '\n';
+				line.clear();
+			}
+		}
+	}
+
+	// Maze with one wall in ten between passages knocked through, so that
+	// there are several best routes, from the bottom left to the top right.
+	static void day16(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		const int side = oddAtLeast(size, 5);
+		CharGrid grid = carveMaze(side, rng);
+
+		for (int y = 1; y < side - 1; ++y)
+		{
+			for (int x = 1; x < side - 1; ++x)
+			{
+				if (grid[y][x] != '#' || (x + y) % 2 == 0)
+					continue;
+
+				const bool horizontal = grid[y][x - 1] == '.' && grid[y][x + 1] == '.';
+				const bool vertical = grid[y - 1][x] == '.' && grid[y + 1][x] == '.';
+				if ((horizontal || vertical) && chance(rng, 10))
+					grid[y][x] = '.';
+			}
+		}
+
+		grid[side - 2][1] = 'S';
+		grid[1][side - 2] = 'E';
+		writeGrid(out, grid);
+	}
+
+	// The real inputs are all one program shape, differing only in constants:
+	//   2,4 1,k1 7,5 4,k3 1,k2 0,3 5,5 3,0
+	// Constants are redrawn until a register A exists that makes the program
+	// print itself, since part two searches for it. Register A for part one
+	// gets size octal digits (at most 21, to fit in 64 bits); the program
+	// length is fixed by the shape, so that is the only thing that scales.
+	static void day17(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		const int digits = (int) std::clamp<uint64_t>(size, 1, 21);
+
+		while (true)
+		{
+			const int k1 = (int) uniform(rng, 0, 7);
+			const int k2 = (int) uniform(rng, 0, 7);
+			const int k3 = (int) uniform(rng, 0, 7);
+			const int program[] = {2, 4, 1, k1, 7, 5, 4, k3, 1, k2, 0, 3, 5, 5, 3, 0};
+			constexpr int length = (int) std::size(program);
+
+			auto firstOutput = [&] (uint64_t a)
+			{
+				const uint64_t b = (a % 8) ^ k1;
+				return (int) (((b ^ (a >> b)) ^ k2) % 8);
+			};
+
+			// Rebuild A three bits at a time, from the last output back to the first.
+			std::function<bool(int, uint64_t)> hasQuine = [&] (int index, uint64_t a)
+			{
+				for (uint64_t digit = 0; digit < 8; ++digit)
+				{
+					const uint64_t next = a * 8 + digit;
+					if (next != 0 && firstOutput(next) == program[index] && (index == 0 || hasQuine(index - 1, next)))
+						return true;
+				}
+				return false;
+			};
+
+			if (!hasQuine(length - 1, 0))
+				continue;
+
+			uint64_t registerA = (uint64_t) uniform(rng, 1, 7);
+			for (int i = 1; i < digits; ++i)
+				registerA = registerA * 8 + (uint64_t) uniform(rng, 0, 7);
+
+			out << "Register A: " << registerA << '\n'
+				<< "Register B: 0\n"
+				<< "Register C: 0\n"
+				<< '\n'
+				<< "Program: ";
+
+			for (int i = 0; i < length; ++i)
+				out << (i == 0 ? "" : ",") << program[i];
+			out << '\n';
+			return;
+		}
+	}
+
+	// A size x size memory space. Every byte but the corners eventually
+	// falls, in random order, except that one staircase route from corner to
+	// corner is left until last: part one (after a fifth of the bytes) always
+	// has a way through and part two always finds the byte that cuts it.
+	static void day18(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		const int side = (int) std::max<uint64_t>(size, 3);
+
+		std::vector<uint8_t> onRoute((size_t) side * side, 0);
+		std::vector<Vec2> route;
+		for (Vec2 pos = {0, 0}; pos != Vec2{side - 1, side - 1}; )
+		{
+			const bool right = pos.y == side - 1 || (pos.x < side - 1 && chance(rng, 50));
+			pos += right ? Vec2{1, 0} : Vec2{0, 1};
+			onRoute[(size_t) pos.y * side + pos.x] = 1;
+			if (pos != Vec2{side - 1, side - 1})
+				route.push_back(pos);
+		}
+		onRoute[0] = 1;
+
+		std::vector<Vec2> bytes;
+		for (int y = 0; y < side; ++y)
+			for (int x = 0; x < side; ++x)
+				if (!onRoute[(size_t) y * side + x])
+					bytes.push_back({x, y});
+
+		shuffle(bytes, rng);
+		shuffle(route, rng);
+		const size_t partOneCount = std::min(bytes.size(), (size_t) side * side / 5);
+		bytes.insert(bytes.end(), route.begin(), route.end());
+
+		out << side - 1 << '*' << side - 1 << '\n' << partOneCount << '\n';
+		for (const Vec2 pos : bytes)
+			out << pos.x << ',' << pos.y << '\n';
+	}
+
+	// 400 towel patterns, with one of the five colours never available on
+	// its own so that some designs can't be made, then size designs.
+	static void day19(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		static const char colours[] = "wubrg";
+		const char missing = colours[uniform(rng, 0, 4)];
+
+		std::set<std::string> towels;
+		for (const char colour : std::string(colours))
+			if (colour != missing)
+				towels.insert(std::string(1, colour));
+
+		while (towels.size() < 400)
+		{
+			std::string towel((size_t) uniform(rng, 2, 8), ' ');
+			for (char& c : towel)
+				c = colours[uniform(rng, 0, 4)];
+			towels.insert(towel);
+		}
+
+		std::vector<std::string> shuffled(towels.begin(), towels.end());
+		shuffle(shuffled, rng);
+
+		for (size_t i = 0; i < shuffled.size(); ++i)
+			out << (i == 0 ? "" : ", ") << shuffled[i];
+		out << "\n\n";
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			std::string design((size_t) uniform(rng, 40, 60), ' ');
+			for (char& c : design)
+				c = colours[uniform(rng, 0, 4)];
+			out << design << '\n';
+		}
+	}
+
+	// A single track, as the puzzle requires: the route through a random
+	// maze from one corner to the cell furthest from it, with every other
+	// passage filled back in.
+	static void day20(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		const int side = oddAtLeast(size, 5);
+		const CharGrid maze = carveMaze(side, rng);
+
+		const Vec2 start = {1, 1};
+		std::vector<int> parent((size_t) side * side, -1);
+		std::vector<Vec2> queue = {start};
+		parent[(size_t) start.y * side + start.x] = (int) (start.y * side + start.x);
+
+		for (size_t i = 0; i < queue.size(); ++i)
+		{
+			for (const Vec2 dir : Vec2::directions)
+			{
+				const Vec2 next = queue[i] + dir;
+				int& nextParent = parent[(size_t) next.y * side + next.x];
+				if (maze[next.y][next.x] == '.' && nextParent < 0)
+				{
+					nextParent = queue[i].y * side + queue[i].x;
+					queue.push_back(next);
+				}
+			}
+		}
+
+		const Vec2 end = queue.back();
+
+		CharGrid grid(side, std::string(side, '#'));
+		for (int index = end.y * side + end.x; ; index = parent[index])
+		{
+			grid[index / side][index % side] = '.';
+			if (index == start.y * side + start.x)
+				break;
+		}
+
+		grid[start.y][start.x] = 'S';
+		grid[end.y][end.x] = 'E';
+		writeGrid(out, grid);
+	}
+
+	static void day21(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			const int64_t code = uniform(rng, 0, 999);
+			out << (char) ('0' + code / 100) << (char) ('0' + code / 10 % 10) << (char) ('0' + code % 10) << "A\n";
+		}
+	}
+
+	static void day22(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		for (uint64_t i = 0; i < size; ++i)
+			out << uniform(rng, 1, (1 << 24) - 1) << '\n';
+	}
+
+	// size computers (at most 676, the number of two letter names), each
+	// linked to about a dozen others, plus one 13-computer LAN party.
+	static void day23(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		std::vector<std::string> names;
+		for (char first = 'a'; first <= 'z'; ++first)
+			for (char second = 'a'; second <= 'z'; ++second)
+				names.push_back({first, second});
+
+		shuffle(names, rng);
+		names.resize((size_t) std::clamp<uint64_t>(size, 2, names.size()));
+		const int64_t count = (int64_t) names.size();
+
+		std::set<std::pair<int64_t, int64_t>> links;
+		auto link = [&] (int64_t a, int64_t b)
+		{
+			if (a != b)
+				links.insert(std::minmax(a, b));
+		};
+
+		for (int64_t a = 0; a < count; ++a)
+			for (int i = 0; i < 6; ++i)
+				link(a, uniform(rng, 0, count - 1));
+
+		const int64_t partySize = std::min<int64_t>(13, count);
+		for (int64_t a = 0; a < partySize; ++a)
+			for (int64_t b = a + 1; b < partySize; ++b)
+				link(a, b);
+
+		std::vector<std::pair<int64_t, int64_t>> shuffled(links.begin(), links.end());
+		shuffle(shuffled, rng);
+
+		for (auto [a, b] : shuffled)
+		{
+			if (chance(rng, 50))
+				std::swap(a, b);
+			out << names[a] << '-' << names[b] << '\n';
+		}
+	}
+
+	// size gates: a correct ripple-carry adder over as many bits as fit (at
+	// most 63, since part one reads z into 64 bits), with any remaining gates
+	// spent on extra logic that reads from the adder but drives nothing.
+	// The adder is left unswapped; part two is specific to the real input.
+	static void day24(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		const int bits = (int) std::clamp<uint64_t>((size + 3) / 5, 1, 63);
+		const uint64_t adderGates = (uint64_t) bits * 5 - 3;
+		const uint64_t extraGates = size > adderGates ? size - adderGates : 0;
+
+		auto numbered = [] (char prefix, int n)
+		{
+			return std::string{prefix, (char) ('0' + n / 10), (char) ('0' + n % 10)};
+		};
+
+		// Internal wire names: three or more lowercase letters, never starting
+		// with x, y or z.
+		uint64_t nextName = 0;
+		auto newWire = [&] ()
+		{
+			uint64_t n = nextName++;
+			std::string name(1, (char) ('a' + n % 23));
+			n /= 23;
+			for (int i = 0; i < 2 || n > 0; ++i, n /= 26)
+				name += (char) ('a' + n % 26);
+			return name;
+		};
+
+		for (char prefix : {'x', 'y'})
+			for (int i = 0; i < bits; ++i)
+				out << numbered(prefix, i) << ": " << uniform(rng, 0, 1) << '\n';
+		out << '\n';
+
+		std::vector<std::string> gates;
+		std::vector<std::string> wires;
+		auto gate = [&] (const std::string& a, const char* op, const std::string& b, const std::string& output)
+		{
+			gates.push_back(chance(rng, 50) ? a + ' ' + op + ' ' + b + " -> " + output : b + ' ' + op + ' ' + a + " -> " + output);
+			wires.push_back(output);
+		};
+
+		std::string carry;
+		for (int i = 0; i < bits; ++i)
+		{
+			const std::string x = numbered('x', i);
+			const std::string y = numbered('y', i);
+			const std::string z = numbered('z', i);
+			const std::string carryOut = i + 1 == bits ? numbered('z', bits) : newWire();
+			wires.push_back(x);
+			wires.push_back(y);
+
+			if (i == 0)
+			{
+				gate(x, "XOR", y, z);
+				gate(x, "AND", y, carryOut);
+			}
+			else
+			{
+				const std::string sum = newWire();
+				const std::string carry1 = newWire();
+				const std::string carry2 = newWire();
+				gate(x, "XOR", y, sum);
+				gate(x, "AND", y, carry1);
+				gate(sum, "XOR", carry, z);
+				gate(sum, "AND", carry, carry2);
+				gate(carry1, "OR", carry2, carryOut);
+			}
+
+			carry = carryOut;
+		}
+
+		static const char* const ops[] = {"AND", "OR", "XOR"};
+		for (uint64_t i = 0; i < extraGates; ++i)
+		{
+			const std::string a = wires[(size_t) uniform(rng, 0, (int64_t) wires.size() - 1)];
+			const std::string b = wires[(size_t) uniform(rng, 0, (int64_t) wires.size() - 1)];
+			gate(a, ops[uniform(rng, 0, 2)], b, newWire());
+		}
+
+		shuffle(gates, rng);
+		for (const std::string& line : gates)
+			out << line << '\n';
+	}
+
+	// size schematics, locks and keys in roughly equal numbers.
+	static void day25(std::ostream& out, uint64_t size, Rng& rng)
+	{
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			const bool lock = chance(rng, 50);
+			int heights[5];
+			for (int& height : heights)
+				height = (int) uniform(rng, 0, 5);
+
+			out << (i == 0 ? "" : "\n");
+			for (int row = 0; row < 7; ++row)
+			{
+				for (const int height : heights)
+				{
+					const bool filled = lock ? row <= height : row >= 6 - height;
+					out << (filled ? '#' : '.');
+				}
+				out << '\n';
+			}
+		}
+	}
+
+	struct Entry
+	{
+		void (*generate)(std::ostream& out, uint64_t size, Rng& rng) = nullptr;
+		const char* sizeDescription = nullptr;
+	};
+
+	static const Entry entries[] =
+	{
+		{},
+		{day01, "number of location id pairs"},
+		{day02, "number of reports"},
+		{day03, "number of instructions"},
+		{day04, "side of the word search"},
+		{day05, "number of updates"},
+		{day06, "side of the lab"},
+		{day07, "number of equations"},
+		{day08, "side of the map"},
+		{day09, "number of digits in the disk map"},
+		{day10, "side of the map"},
+		{day11, "number of stones"},
+		{day12, "side of the garden"},
+		{day13, "number of claw machines"},
+		{day14, "number of robots"},
+		{day15, "side of the warehouse"},
+		{day16, "side of the maze"},
+		{day17, "octal digits in register A, at most 21"},
+		{day18, "side of the memory space"},
+		{day19, "number of designs"},
+		{day20, "side of the racetrack"},
+		{day21, "number of door codes"},
+		{day22, "number of buyers"},
+		{day23, "number of computers, at most 676"},
+		{day24, "number of gates"},
+		{day25, "number of schematics"},
+	};
+
+	bool has(int day)
+	{
+		return day > 0 && day < (int) std::size(entries) && entries[day].generate;
+	}
+
+	const char* getSizeDescription(int day)
+	{
+		return has(day) ? entries[day].sizeDescription : "";
+	}
+
+	bool generate(int day, uint64_t size, uint64_t seed, std::ostream& out)
+	{
+		if (!has(day))
+			return false;
+
+		// Mix the day in so that days generated with the same seed differ.
+		Rng rng(seed * 100 + day);
+		entries[day].generate(out, size, rng);
+		return true;
+	}
+
+	bool generate(int day, uint64_t size, uint64_t seed, const char* filename)
+	{
+		if (!has(day))
+			return false;
+
+		std::ofstream s{ filename, s.out | s.binary };
+		if (!s.is_open())
+			return false;
+
+		return generate(day, size, seed, s) && s.good();
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+
+// Random but valid puzzle inputs at a chosen scale, for seeing how each
+// solver grows beyond the size of the real inputs. What "size" means depends
+// on the day (see getSizeDescription): a line count for list days, a side
+// length for grid days.
+
+namespace Generators
+{
+	bool has(int day);
+	const char* getSizeDescription(int day);
+
+	// The same day, size and seed always produce the same input.
+	bool generate(int day, uint64_t size, uint64_t seed, std::ostream& out);
+	bool generate(int day, uint64_t size, uint64_t seed, const char* filename);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "Cache.h"
+#include "Vec2.h"
+
+// A width x height grid of cells stored in one row-major block, indexed by
+// Vec2. It can have a border of padding cells on every side, addressed with
+// coordinates just outside [0, width) x [0, height). Filled with a value
+// that stops a search (a wall, say), the border lets a step off the edge
+// land on a real cell, so the search needs no bounds check.
+//
+// Use uint8_t or an enum rather than bool for flags: the cells are a vector,
+// and vector<bool> packs its bits.
+
+template <typename T>
+class Grid
+{
+	static_assert(!std::is_same_v<T, bool>, "Use uint8_t or an enum for bool cells");
+
+public:
+	Grid() = default;
+
+	Grid(int width, int height, const T& value = T(), int padding = 0, const T& border = T())
+		: width(width)
+		, height(height)
+		, padding(padding)
+		, stride(width + padding * 2)
+		, cells((size_t) stride * (height + padding * 2), border)
+	{
+		assert(width >= 0 && height >= 0 && padding >= 0);
+		fill(value);
+	}
+
+	// One cell per character of each line, from toCell(c, pos). The lines
+	// must all be the same length.
+	template <typename Lines, typename ToCell>
+	static Grid fromLines(const Lines& lines, ToCell&& toCell, int padding = 0, const T& border = T())
+	{
+		int rows = 0;
+		int cols = 0;
+		for (std::string_view line : lines)
+		{
+			cols = (int) line.size();
+			++rows;
+		}
+
+		Grid grid(cols, rows, T(), padding, border);
+
+		int y = 0;
+		for (std::string_view line : lines)
+		{
+			assert((int) line.size() == cols);
+
+			for (int x = 0; x < cols; ++x)
+			{
+				const Vec2 pos{x, y};
+				grid[pos] = toCell(line[x], pos);
+			}
+
+			++y;
+		}
+
+		return grid;
+	}
+
+	int getWidth() const { return width; }
+	int getHeight() const { return height; }
+	int getPadding() const { return padding; }
+
+	EZBounds getBounds() const { return {width, height}; }
+	bool isInBounds(Vec2 pos) const { return getBounds().isInBounds(pos); }
+
+	T& operator[](Vec2 pos) { return cells[getIndex(pos)]; }
+	const T& operator[](Vec2 pos) const { return cells[getIndex(pos)]; }
+
+	// Sets every cell inside the bounds, leaving the border as it is.
+	void fill(const T& value)
+	{
+		for (int y = 0; y < height; ++y)
+		{
+			const auto row = cells.begin() + getIndex({0, y});
+			std::fill(row, row + width, value);
+		}
+	}
+
+	friend void serialize(Cache::Archive& archive, Grid& grid)
+	{
+		archive(grid.width, grid.height, grid.padding, grid.stride, grid.cells);
+	}
+
+private:
+	size_t getIndex(Vec2 pos) const
+	{
+		assert(-padding <= pos.x && pos.x < width + padding);
+		assert(-padding <= pos.y && pos.y < height + padding);
+		return (size_t) (pos.y + padding) * stride + (pos.x + padding);
+	}
+
+	int width = 0;
+	int height = 0;
+	int padding = 0;
+	int stride = 0;
+	std::vector<T> cells;
+};
@@ -0,0 +1,295 @@
+#include "Harness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+
+#include "Generators.h"
+
+namespace Harness
+{
+	static BenchmarkOptions benchmarkOptions;
+	static std::mutex resultsMutex;
+	static std::vector<BenchmarkResult> results;
+	static volatile uint64_t sink = 0;
+
+	void setBenchmarkOptions(const BenchmarkOptions& options)
+	{
+		assert(options.measuredRuns > 0);
+		benchmarkOptions = options;
+	}
+
+	const BenchmarkOptions& getBenchmarkOptions()
+	{
+		return benchmarkOptions;
+	}
+
+	void doNotOptimise(uint64_t value)
+	{
+		sink = value;
+	}
+
+	uint64_t getFileSize(const char* filename)
+	{
+		std::error_code error;
+		const uintmax_t size = std::filesystem::file_size(filename, error);
+		return error ? 0 : size;
+	}
+
+	PhaseStats summarise(std::string phase, std::vector<double> seconds, uint64_t inputBytes)
+	{
+		assert(!seconds.empty());
+		std::sort(seconds.begin(), seconds.end());
+
+		// Nearest-rank percentile.
+		auto percentile = [&] (double p)
+		{
+			const size_t rank = (size_t) std::ceil(p * seconds.size());
+			return seconds[std::clamp<size_t>(rank, 1, seconds.size()) - 1];
+		};
+
+		PhaseStats stats;
+		stats.phase = std::move(phase);
+		stats.samples = seconds.size();
+		stats.min = seconds.front();
+		stats.median = percentile(0.5);
+		stats.p95 = percentile(0.95);
+		stats.p99 = percentile(0.99);
+		stats.bytesPerSecond = stats.median > 0.0 ? inputBytes / stats.median : 0.0;
+		return stats;
+	}
+
+	void printMetrics(const PhaseMetrics (&metrics)[PhaseCount])
+	{
+		static const char* const labels[PhaseCount] = { "Load:  ", "Part 1:", "Part 2:" };
+		std::ostream& out = Days::out();
+
+		if constexpr (Alloc::isTracking)
+			for (int phase = 0; phase < PhaseCount; ++phase)
+				out << "  " << labels[phase] << ' ' << metrics[phase].allocs << '\n';
+
+		if (Perf::isEnabled())
+			for (int phase = 0; phase < PhaseCount; ++phase)
+				out << "  " << labels[phase] << ' ' << metrics[phase].perf << '\n';
+
+		out.flush();
+	}
+
+	void printMetrics(const char* label, const PhaseMetrics& metrics)
+	{
+		std::ostream& out = Days::out();
+
+		if constexpr (Alloc::isTracking)
+			out << "  " << label << ' ' << metrics.allocs << '\n';
+
+		if (Perf::isEnabled())
+			out << "  " << label << ' ' << metrics.perf << '\n';
+
+		out.flush();
+	}
+
+	void report(BenchmarkResult result)
+	{
+		std::ostream& out = Days::out();
+		const std::ios::fmtflags flags = out.flags();
+		const std::streamsize precision = out.precision();
+
+		out << "Benchmark " << result.input << " (" << result.inputBytes << " bytes)\n";
+		for (const PhaseStats& stats : result.phases)
+		{
+			out << "  " << std::left << std::setw(8) << stats.phase << std::right << std::fixed << std::setprecision(1)
+				<< " min " << std::setw(12) << stats.min * 1e6 << "us"
+				<< " median " << std::setw(12) << stats.median * 1e6 << "us"
+				<< " p95 " << std::setw(12) << stats.p95 * 1e6 << "us"
+				<< " p99 " << std::setw(12) << stats.p99 * 1e6 << "us"
+				<< " " << std::setw(10) << stats.bytesPerSecond / (1024.0 * 1024.0) << " MiB/s";
+
+			if constexpr (Alloc::isTracking)
+				out << "  " << stats.metrics.allocs;
+			if (Perf::isEnabled())
+				out << "  " << stats.metrics.perf;
+
+			out << '\n';
+		}
+		out.flags(flags);
+		out.precision(precision);
+
+		std::lock_guard lock(resultsMutex);
+		results.push_back(std::move(result));
+	}
+
+	bool sweep(int day, const std::vector<uint64_t>& sizes, uint64_t seed)
+	{
+		assert(benchmarkOptions.enabled);
+
+		const Days::Day* registered = Days::find(day);
+		if (!registered || !registered->solver || !Generators::has(day))
+		{
+			std::cerr << "Day " << day << " has no generator or solver to sweep" << std::endl;
+			return false;
+		}
+
+		std::ostringstream directory;
+		directory << "../data/" << std::setw(2) << std::setfill('0') << day << "/generated";
+
+		std::error_code error;
+		std::filesystem::create_directories(directory.str(), error);
+
+		std::vector<BenchmarkResult> sweepResults;
+		std::vector<uint64_t> sweepSizes;
+
+		for (const uint64_t size : sizes)
+		{
+			const std::string filename = directory.str() + "/" + std::to_string(size) + ".txt";
+
+			Days::out() << "Generating " << filename << " (" << Generators::getSizeDescription(day) << ": " << size << ")" << std::endl;
+			if (!Generators::generate(day, size, seed, filename.c_str()))
+			{
+				std::cerr << "Could not write " << filename << std::endl;
+				return false;
+			}
+
+			Days::solve(day, filename.c_str());
+
+			std::lock_guard lock(resultsMutex);
+			if (!results.empty() && results.back().input == filename)
+			{
+				sweepResults.push_back(results.back());
+				sweepSizes.push_back(size);
+			}
+		}
+
+		std::ostream& out = Days::out();
+		const std::ios::fmtflags flags = out.flags();
+		const std::streamsize precision = out.precision();
+
+		// k is the local growth exponent: time ~ bytes^k between this row and
+		// the previous one, so 1 is linear and 2 quadratic.
+		out << "Scaling of day " << day << " (size = " << Generators::getSizeDescription(day) << ")\n"
+			<< std::setw(12) << "size" << std::setw(14) << "bytes";
+		// Streamed days have a single "stream" phase rather than one per part.
+		if (!sweepResults.empty())
+			for (const PhaseStats& phase : sweepResults.front().phases)
+				out << std::setw(14) << phase.phase + " us" << std::setw(6) << "k";
+		out << '\n' << std::fixed;
+
+		for (size_t i = 0; i < sweepResults.size(); ++i)
+		{
+			const BenchmarkResult& result = sweepResults[i];
+			out << std::setw(12) << sweepSizes[i] << std::setw(14) << result.inputBytes;
+
+			for (size_t phase = 0; phase < result.phases.size(); ++phase)
+			{
+				const double median = result.phases[phase].median;
+				out << std::setprecision(1) << std::setw(14) << median * 1e6;
+
+				const BenchmarkResult* previous = i > 0 ? &sweepResults[i - 1] : nullptr;
+				const double previousMedian = previous ? previous->phases[phase].median : 0.0;
+
+				if (previous && previousMedian > 0.0 && median > 0.0 && result.inputBytes != previous->inputBytes && previous->inputBytes > 0)
+				{
+					const double k = std::log(median / previousMedian) / std::log((double) result.inputBytes / previous->inputBytes);
+					out << std::setprecision(2) << std::setw(6) << k;
+				}
+				else
+				{
+					out << std::setw(6) << "-";
+				}
+			}
+			out << '\n';
+		}
+
+		out.flags(flags);
+		out.precision(precision);
+		out.flush();
+		return true;
+	}
+
+	static std::string escapeJson(const std::string& str)
+	{
+		std::string escaped;
+		for (char c : str)
+		{
+			if (c == '"' || c == '\\')
+				escaped += '\\';
+			escaped += c;
+		}
+		return escaped;
+	}
+
+	void clearBenchmarkResults()
+	{
+		std::lock_guard lock(resultsMutex);
+		results.clear();
+	}
+
+	bool writeBenchmarkJson(const char* filename)
+	{
+		std::ofstream s{ filename };
+		if (!s.is_open())
+			return false;
+
+		std::lock_guard lock(resultsMutex);
+
+		s << "{\n"
+			<< "  \"warmupRuns\": " << benchmarkOptions.warmupRuns << ",\n"
+			<< "  \"measuredRuns\": " << benchmarkOptions.measuredRuns << ",\n"
+			<< "  \"results\": [";
+
+		s << std::setprecision(9);
+
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			const BenchmarkResult& result = results[i];
+
+			s << (i == 0 ? "\n" : ",\n")
+				<< "    {\n"
+				<< "      \"day\": " << result.day << ",\n"
+				<< "      \"input\": \"" << escapeJson(result.input) << "\",\n"
+				<< "      \"inputBytes\": " << result.inputBytes << ",\n"
+				<< "      \"phases\": [";
+
+			for (size_t j = 0; j < result.phases.size(); ++j)
+			{
+				const PhaseStats& stats = result.phases[j];
+
+				s << (j == 0 ? "\n" : ",\n")
+					<< "        {"
+					<< " \"phase\": \"" << stats.phase << "\","
+					<< " \"samples\": " << stats.samples << ","
+					<< " \"minSeconds\": " << stats.min << ","
+					<< " \"medianSeconds\": " << stats.median << ","
+					<< " \"p95Seconds\": " << stats.p95 << ","
+					<< " \"p99Seconds\": " << stats.p99 << ","
+					<< " \"bytesPerSecond\": " << stats.bytesPerSecond;
+
+				if constexpr (Alloc::isTracking)
+				{
+					s << ","
+						<< " \"allocations\": " << stats.metrics.allocs.allocations << ","
+						<< " \"allocatedBytes\": " << stats.metrics.allocs.bytes << ","
+						<< " \"peakLiveBytes\": " << stats.metrics.allocs.peakLiveBytes;
+				}
+
+				const Perf::Counts& perf = stats.metrics.perf;
+				for (int event = 0; event < Perf::EventCount; ++event)
+					if (perf.valid[event])
+						s << ", \"" << Perf::getEventName((Perf::Event) event) << "\": " << perf.values[event];
+				if (perf.valid[Perf::Cycles] && perf.valid[Perf::Instructions])
+					s << ", \"ipc\": " << perf.ipc();
+
+				s << " }";
+			}
+
+			s << "\n      ]\n    }";
+		}
+
+		s << "\n  ]\n}\n";
+		return true;
+	}
+}
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Alloc.h"
+#include "Cache.h"
+#include "Days.h"
+#include "Perf.h"
+#include "Stream.h"
+
+namespace Harness
+{
+	struct BenchmarkOptions
+	{
+		bool enabled = false;
+		int warmupRuns = 2;
+		int measuredRuns = 10;
+	};
+
+	void setBenchmarkOptions(const BenchmarkOptions& options);
+	const BenchmarkOptions& getBenchmarkOptions();
+
+	// What was measured around the single run of a phase that checked the answers.
+	struct PhaseMetrics
+	{
+		Alloc::Counts allocs;
+		Perf::Counts perf;
+	};
+
+	template <typename Fn>
+	decltype(auto) measure(PhaseMetrics& metrics, Fn&& fn)
+	{
+		// Perf innermost, so that the allocation bookkeeping isn't counted.
+		return Alloc::track(metrics.allocs, [&] { return Perf::track(metrics.perf, fn); });
+	}
+
+	// Timing summary for one phase (load, part one or part two) of one input.
+	struct PhaseStats
+	{
+		std::string phase;
+		size_t samples = 0;
+		double min = 0.0;
+		double median = 0.0;
+		double p95 = 0.0;
+		double p99 = 0.0;
+		double bytesPerSecond = 0.0; // input size over median time
+		PhaseMetrics metrics; // from the run that checked the answers
+	};
+
+	struct BenchmarkResult
+	{
+		int day = 0;
+		std::string input;
+		uint64_t inputBytes = 0;
+		std::vector<PhaseStats> phases;
+	};
+
+	PhaseStats summarise(std::string phase, std::vector<double> seconds, uint64_t inputBytes);
+	uint64_t getFileSize(const char* filename);
+
+	// Prints the result to Days::out() and keeps it for writeBenchmarkJson().
+	void report(BenchmarkResult result);
+	bool writeBenchmarkJson(const char* filename);
+
+	// Forgets the results kept so far, for processes that outlive one run.
+	void clearBenchmarkResults();
+
+	// Generates an input of each size for the day (see Generators.h) under
+	// ../data/NN/generated, benchmarks the day's solver on each one and prints
+	// how each phase's median time grows with the input. Benchmarking must be
+	// enabled.
+	bool sweep(int day, const std::vector<uint64_t>& sizes, uint64_t seed);
+
+	// Keeps the optimiser from discarding a result that is otherwise unused.
+	void doNotOptimise(uint64_t value);
+	inline void doNotOptimise(const std::string& value) { doNotOptimise(value.size()); }
+
+	template <typename Fn>
+	std::vector<double> timeRuns(Fn&& fn)
+	{
+		using Clock = std::chrono::steady_clock;
+		const BenchmarkOptions& options = getBenchmarkOptions();
+
+		for (int i = 0; i < options.warmupRuns; ++i)
+			doNotOptimise(fn());
+
+		std::vector<double> seconds;
+		seconds.reserve(options.measuredRuns);
+
+		for (int i = 0; i < options.measuredRuns; ++i)
+		{
+			const Clock::time_point start = Clock::now();
+			const auto result = fn();
+			seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+			doNotOptimise(result);
+		}
+
+		return seconds;
+	}
+
+	enum Phase
+	{
+		Load,
+		PartOne,
+		PartTwo,
+
+		PhaseCount
+	};
+
+	// Loads through the binary cache when it is enabled and the day's data
+	// type supports it (see Cache.h), otherwise just parses.
+	template <typename LoadFn>
+	auto loadInput(const char* filename, LoadFn&& loadData)
+	{
+		using Data = std::decay_t<decltype(loadData(filename))>;
+
+		if constexpr (Cache::Cacheable<Data>)
+		{
+			if (Cache::isEnabled())
+				return Cache::load<Data>(filename, loadData);
+		}
+
+		return loadData(filename);
+	}
+
+	// Prints whichever of the allocation and perf counts are being collected.
+	void printMetrics(const PhaseMetrics (&metrics)[PhaseCount]);
+	void printMetrics(const char* label, const PhaseMetrics& metrics);
+
+	template <typename LoadFn, typename PartOneFn, typename PartTwoFn>
+	void benchmark(const char* filename, LoadFn&& loadData, PartOneFn&& partOne, PartTwoFn&& partTwo, const PhaseMetrics (&metrics)[PhaseCount])
+	{
+		const auto data = loadData(filename);
+
+		BenchmarkResult result;
+		result.day = Days::currentDay();
+		result.input = filename;
+		result.inputBytes = getFileSize(filename);
+
+		const auto loadTimes = timeRuns([&]
+		{
+			const auto loaded = loadData(filename);
+			return (uint64_t) sizeof(loaded);
+		});
+
+		result.phases.push_back(summarise("load", loadTimes, result.inputBytes));
+		result.phases.push_back(summarise("partOne", timeRuns([&] { return partOne(data); }), result.inputBytes));
+		result.phases.push_back(summarise("partTwo", timeRuns([&] { return partTwo(data); }), result.inputBytes));
+
+		for (int phase = 0; phase < PhaseCount; ++phase)
+			result.phases[phase].metrics = metrics[phase];
+
+		report(std::move(result));
+	}
+
+	enum class Execution
+	{
+		Concurrent, // part two runs on its own thread alongside part one
+		Serial, // for days whose parts share mutable state, such as a static memo table
+	};
+
+	template <Execution execution, typename Data, typename PartOneFn, typename PartTwoFn>
+	auto runParts(const Data& data, PartOneFn&& partOne, PartTwoFn&& partTwo, PhaseMetrics (&metrics)[PhaseCount])
+	{
+		if constexpr (execution == Execution::Serial)
+		{
+			auto result1 = measure(metrics[PartOne], [&] { return partOne(data); });
+			auto result2 = measure(metrics[PartTwo], [&] { return partTwo(data); });
+			return std::make_pair(std::move(result1), std::move(result2));
+		}
+		else
+		{
+			// Part two prints into its own buffer, added after part one's output
+			// so that the two don't interleave.
+			std::ostringstream partTwoOut;
+			const int day = Days::currentDay();
+
+			auto partTwoResult = std::async(std::launch::async, [&]
+			{
+				Days::Scope scope(day, partTwoOut);
+				return measure(metrics[PartTwo], [&] { return partTwo(data); });
+			});
+
+			auto result1 = measure(metrics[PartOne], [&] { return partOne(data); });
+			auto result2 = partTwoResult.get();
+
+			Days::out() << partTwoOut.str();
+			return std::make_pair(std::move(result1), std::move(result2));
+		}
+	}
+
+	// The body every day used to copy from templateday.cpp: load the input, run
+	// both parts, print the answers and check them against any expected values
+	// (a default-constructed expected value means "not known yet").
+	//
+	// The two parts run concurrently unless the day asks for Execution::Serial.
+	template <Execution execution = Execution::Concurrent, typename LoadFn, typename PartOneFn, typename PartTwoFn, typename Expected1, typename Expected2>
+	void processPrintAndAssert(
+		const char* filename,
+		LoadFn&& loadData,
+		PartOneFn&& partOne,
+		PartTwoFn&& partTwo,
+		[[maybe_unused]] Expected1 expected1,
+		[[maybe_unused]] Expected2 expected2)
+	{
+		auto load = [&] (const char* name) { return loadInput(name, loadData); };
+
+		PhaseMetrics metrics[PhaseCount];
+		const auto data = measure(metrics[Load], [&] { return load(filename); });
+		const auto [result1, result2] = runParts<execution>(data, partOne, partTwo, metrics);
+
+		Days::out() << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
+		printMetrics(metrics);
+
+		assert(expected1 == decltype(expected1){} || result1 == expected1);
+		assert(expected2 == decltype(expected2){} || result2 == expected2);
+
+		if (getBenchmarkOptions().enabled)
+			benchmark(filename, load, partOne, partTwo, metrics);
+	}
+
+	// For days whose answers are reductions over independent lines: solves
+	// the day without loading the input, a chunk at a time (see Stream.h).
+	// The Reducer's add() is given each line as it is read, after which
+	// partOne() and partTwo() give the answers. Days use this in place of
+	// processPrintAndAssert when Stream::isEnabled().
+	template <typename Reducer, typename Expected1, typename Expected2>
+	void streamPrintAndAssert(
+		const char* filename,
+		[[maybe_unused]] Expected1 expected1,
+		[[maybe_unused]] Expected2 expected2)
+	{
+		auto stream = [] (const char* name)
+		{
+			Reducer reducer;
+			Stream::forEachLine(name, [&] (std::string_view line) { reducer.add(line); });
+			return std::make_pair(reducer.partOne(), reducer.partTwo());
+		};
+
+		PhaseMetrics metrics;
+		const auto [result1, result2] = measure(metrics, [&] { return stream(filename); });
+
+		Days::out() << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
+		printMetrics("Stream:", metrics);
+
+		assert(expected1 == decltype(expected1){} || result1 == expected1);
+		assert(expected2 == decltype(expected2){} || result2 == expected2);
+
+		if (getBenchmarkOptions().enabled)
+		{
+			BenchmarkResult result;
+			result.day = Days::currentDay();
+			result.input = filename;
+			result.inputBytes = getFileSize(filename);
+
+			const auto times = timeRuns([&] { return stream(filename).first; });
+			result.phases.push_back(summarise("stream", times, result.inputBytes));
+			result.phases.back().metrics = metrics;
+
+			report(std::move(result));
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const char* filename)
+{
+	file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		file = nullptr;
+		return;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+		return;
+
+	length = (size_t) fileSize.QuadPart;
+	if (length == 0)
+	{
+		open = true;
+		return;
+	}
+
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping)
+		return;
+
+	bytes = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	open = bytes != nullptr;
+}
+
+MappedFile::~MappedFile()
+{
+	if (bytes)
+		UnmapViewOfFile(bytes);
+	if (mapping)
+		CloseHandle(mapping);
+	if (file)
+		CloseHandle(file);
+}
+#else
+MappedFile::MappedFile(const char* filename)
+{
+	const int fd = ::open(filename, O_RDONLY);
+	if (fd < 0)
+		return;
+
+	struct stat info;
+	if (fstat(fd, &info) == 0)
+	{
+		length = (size_t) info.st_size;
+
+		if (length == 0)
+		{
+			open = true;
+		}
+		else
+		{
+			void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapped != MAP_FAILED)
+			{
+				bytes = static_cast<const char*>(mapped);
+				open = true;
+				madvise(mapped, length, MADV_SEQUENTIAL);
+			}
+		}
+	}
+
+	// The mapping keeps the file alive on its own.
+	close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+	if (bytes)
+		munmap(const_cast<char*>(bytes), length);
+}
+#endif
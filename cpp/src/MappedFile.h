@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+// Read-only view of a whole file, mapped into memory rather than read. An
+// empty file opens successfully with a null data() and a size() of zero.
+class MappedFile
+{
+public:
+	explicit MappedFile(const char* filename);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool isOpen() const { return open; }
+	const char* data() const { return bytes; }
+	size_t size() const { return length; }
+
+private:
+	const char* bytes = nullptr;
+	size_t length = 0;
+	bool open = false;
+
+#ifdef _WIN32
+	void* file = nullptr;
+	void* mapping = nullptr;
+#endif
+};
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Stats.h"
+
+// A memo table for recursive solvers, in place of a function-local static
+// std::map. Lookups hash the key, so pairs and tuples of hashable things work
+// as keys without writing a hash for them.
+//
+// It is safe to share between threads: entries are split across shards,
+// each with its own lock, so callers on different threads rarely wait on
+// each other. No lock is held while a value is computed, so the computation
+// can recurse into the same memo; two threads asking for the same missing
+// key may both compute it, and the first to finish wins.
+//
+// A capacity bounds how many entries are kept. Each shard fills a recent
+// table, and when that is half the shard's share it becomes the old table,
+// dropping the previous old one. Hits in the old table move back to the
+// recent one, so what is still in use survives.
+//
+// Give a memo the lifetime of the data its values depend on: a local for
+// ones that depend on the input, a static only for pure functions of the key.
+//
+// A memo given a name counts its hits, misses and evictions as stats of the
+// day that made it, in builds with AOC_STATS (see Stats.h).
+
+struct MemoHash
+{
+	template <typename T>
+	size_t operator()(const T& value) const
+	{
+		if constexpr (requires { std::tuple_size<T>::value; })
+		{
+			return std::apply([this] (const auto&... parts)
+			{
+				size_t seed = 0;
+				((seed = combine(seed, (*this)(parts))), ...);
+				return seed;
+			}, value);
+		}
+		else
+		{
+			return std::hash<T>()(value);
+		}
+	}
+
+	static size_t combine(size_t seed, size_t hash)
+	{
+		const uint64_t mixed = (seed ^ hash) * 0x9e3779b97f4a7c15ull;
+		return (size_t) (mixed ^ (mixed >> 32));
+	}
+};
+
+template <typename Key, typename Value, typename Hash = MemoHash>
+class Memo
+{
+public:
+	static constexpr size_t unlimited = SIZE_MAX;
+
+	struct Options
+	{
+		size_t capacity = unlimited;
+		size_t numShards = 1; // more for memos shared by parallel loops
+		const char* name = nullptr; // for stats
+	};
+
+	Memo() : Memo(Options()) {}
+
+	explicit Memo(Options options)
+		: counters(options.name)
+		, shardCapacity(options.capacity == unlimited ? unlimited : std::max<size_t>(2, options.capacity / std::max<size_t>(1, options.numShards)))
+	{
+		shards.resize(std::max<size_t>(1, options.numShards));
+		for (std::unique_ptr<Shard>& shard : shards)
+			shard = std::make_unique<Shard>();
+	}
+
+	std::optional<Value> find(const Key& key)
+	{
+		Shard& shard = getShard(key);
+		std::lock_guard lock(shard.mutex);
+
+		if (auto iter = shard.recent.find(key); iter != shard.recent.end())
+		{
+			counters.add(counters.hits);
+			return iter->second;
+		}
+
+		if (auto iter = shard.old.find(key); iter != shard.old.end())
+		{
+			counters.add(counters.hits);
+			Value value = std::move(iter->second);
+			shard.old.erase(iter);
+			add(shard, key, value);
+			return value;
+		}
+
+		counters.add(counters.misses);
+		return std::nullopt;
+	}
+
+	void insert(const Key& key, const Value& value)
+	{
+		Shard& shard = getShard(key);
+		std::lock_guard lock(shard.mutex);
+
+		if (!shard.recent.contains(key) && !shard.old.contains(key))
+			add(shard, key, value);
+	}
+
+	// The memoised value for key, computing it with compute() if need be.
+	template <typename Compute>
+	Value get(const Key& key, Compute&& compute)
+	{
+		if (std::optional<Value> value = find(key))
+			return std::move(*value);
+
+		Value value = compute();
+		insert(key, value);
+		return value;
+	}
+
+	void clear()
+	{
+		for (std::unique_ptr<Shard>& shard : shards)
+		{
+			std::lock_guard lock(shard->mutex);
+			shard->recent.clear();
+			shard->old.clear();
+		}
+	}
+
+	size_t size() const
+	{
+		size_t count = 0;
+		for (const std::unique_ptr<Shard>& shard : shards)
+		{
+			std::lock_guard lock(shard->mutex);
+			count += shard->recent.size() + shard->old.size();
+		}
+		return count;
+	}
+
+private:
+	struct Counters
+	{
+#ifdef AOC_STATS
+		Stats::Stat* hits = nullptr;
+		Stats::Stat* misses = nullptr;
+		Stats::Stat* evictions = nullptr;
+
+		explicit Counters(const char* name)
+		{
+			if (!name)
+				return;
+
+			hits = &Stats::registerStat(std::string(name) + " hits", false);
+			misses = &Stats::registerStat(std::string(name) + " misses", false);
+			evictions = &Stats::registerStat(std::string(name) + " evictions", false);
+		}
+
+		static void add(Stats::Stat* stat, uint64_t n = 1)
+		{
+			if (stat)
+				stat->count.fetch_add(n, std::memory_order_relaxed);
+		}
+#else
+		static constexpr std::nullptr_t hits = nullptr;
+		static constexpr std::nullptr_t misses = nullptr;
+		static constexpr std::nullptr_t evictions = nullptr;
+
+		explicit Counters(const char*) {}
+		static void add(std::nullptr_t, uint64_t = 1) {}
+#endif
+	};
+
+	using Table = std::unordered_map<Key, Value, Hash>;
+
+	struct Shard
+	{
+		mutable std::mutex mutex;
+		Table recent;
+		Table old;
+	};
+
+	Shard& getShard(const Key& key)
+	{
+		if (shards.size() == 1)
+			return *shards.front();
+
+		// The tables index by the low bits of the hash, so pick shards by
+		// the high ones.
+		const uint64_t mixed = (uint64_t) Hash()(key) * 0x9e3779b97f4a7c15ull;
+		return *shards[(size_t) (mixed >> 32) % shards.size()];
+	}
+
+	void add(Shard& shard, const Key& key, const Value& value)
+	{
+		if (shardCapacity != unlimited && shard.recent.size() >= shardCapacity / 2)
+		{
+			counters.add(counters.evictions, shard.old.size());
+			shard.old = std::exchange(shard.recent, Table());
+		}
+
+		shard.recent.emplace(key, value);
+	}
+
+	Counters counters;
+	size_t shardCapacity = unlimited;
+	std::vector<std::unique_ptr<Shard>> shards;
+};
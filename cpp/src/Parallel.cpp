@@ -0,0 +1,307 @@
+#include "Parallel.h"
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include "Alloc.h"
+#include "Days.h"
+#include "Perf.h"
+
+namespace Parallel
+{
+	// Aim for a few chunks per thread on any machine, so that threads that
+	// finish early have work to steal.
+	static constexpr size_t maxChunks = 256;
+
+	Chunks::Chunks(size_t begin, size_t end, size_t minChunkSize)
+		: begin(begin)
+		, end(std::max(begin, end))
+	{
+		const size_t length = this->end - begin;
+		size = std::max({minChunkSize, (length + maxChunks - 1) / maxChunks, size_t(1)});
+		count = (length + size - 1) / size;
+	}
+
+	// One call of runChunks.
+	struct Batch
+	{
+		const std::function<void(size_t)>* fn = nullptr;
+		int day = 0;
+		std::ostream* out = nullptr;
+		std::thread::id owner;
+
+		// Chunks not yet finished. Only counted down under doneMutex, so
+		// that the owner can't return (and free the batch) between the
+		// last chunk finishing and done being signalled.
+		std::atomic<size_t> remaining = 0;
+		std::mutex doneMutex;
+		std::condition_variable done;
+
+		// The metrics of chunks run on other threads than the owner, for
+		// the owner to add to its own.
+		std::mutex handoffMutex;
+		Alloc::Handoff allocs;
+		std::optional<Perf::Counts> perf;
+	};
+
+	struct Task
+	{
+		Batch* batch = nullptr;
+		size_t chunk = 0;
+	};
+
+	class Pool
+	{
+	public:
+		explicit Pool(unsigned numThreads);
+		~Pool();
+
+		void run(Batch& batch, size_t count);
+
+	private:
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		size_t getQueueIndex() const;
+		bool take(size_t queueIndex, Task& task);
+		bool runOne(size_t queueIndex);
+		void work(size_t queueIndex);
+
+		// One per worker, then one for loops started outside the pool.
+		std::vector<std::unique_ptr<Queue>> queues;
+		std::vector<std::thread> workers;
+
+		std::atomic<size_t> numPending = 0;
+		std::mutex sleepMutex;
+		std::condition_variable wake;
+		bool stopping = false;
+	};
+
+	static thread_local const Pool* currentPool = nullptr;
+	static thread_local size_t currentQueue = 0;
+
+	Pool::Pool(unsigned numThreads)
+	{
+		assert(numThreads > 1);
+
+		for (unsigned i = 0; i < numThreads; ++i)
+			queues.push_back(std::make_unique<Queue>());
+
+		for (unsigned i = 0; i + 1 < numThreads; ++i)
+			workers.emplace_back([this, i] { work(i); });
+	}
+
+	Pool::~Pool()
+	{
+		{
+			std::lock_guard lock(sleepMutex);
+			stopping = true;
+		}
+		wake.notify_all();
+
+		for (std::thread& worker : workers)
+			worker.join();
+	}
+
+	size_t Pool::getQueueIndex() const
+	{
+		return currentPool == this ? currentQueue : queues.size() - 1;
+	}
+
+	// Runs a chunk as the day that started its loop. A chunk run on another
+	// thread has its allocations and perf events handed back to the loop's
+	// thread, so that a phase's metrics cover all its work however it was
+	// spread over the pool.
+	static void runTask(const Task& task)
+	{
+		Batch& batch = *task.batch;
+		Days::Scope scope(batch.day, *batch.out);
+
+		if (std::this_thread::get_id() == batch.owner || !(Alloc::isTracking || Perf::isEnabled()))
+		{
+			(*batch.fn)(task.chunk);
+			return;
+		}
+
+		Alloc::HandoffScope allocScope;
+		std::optional<Perf::HandoffScope> perfScope;
+		if (Perf::isEnabled())
+			perfScope.emplace();
+
+		(*batch.fn)(task.chunk);
+
+		const std::optional<Perf::Counts> perf = perfScope ? std::optional(perfScope->finish()) : std::nullopt;
+		const Alloc::Handoff allocs = allocScope.finish();
+
+		std::lock_guard lock(batch.handoffMutex);
+		batch.allocs.add(allocs);
+		if (perf && batch.perf)
+			batch.perf->add(*perf);
+		else if (perf)
+			batch.perf = perf;
+	}
+
+	// Takes the newest task from the given queue, or failing that steals the
+	// oldest from another. False if there were none anywhere.
+	bool Pool::take(size_t queueIndex, Task& task)
+	{
+		for (size_t i = 0; i < queues.size(); ++i)
+		{
+			Queue& queue = *queues[(queueIndex + i) % queues.size()];
+
+			std::lock_guard lock(queue.mutex);
+			if (queue.tasks.empty())
+				continue;
+
+			if (i == 0)
+			{
+				task = queue.tasks.back();
+				queue.tasks.pop_back();
+			}
+			else
+			{
+				task = queue.tasks.front();
+				queue.tasks.pop_front();
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	// Runs a task from the given queue or stolen from another. False if there
+	// were none anywhere.
+	bool Pool::runOne(size_t queueIndex)
+	{
+		Task task;
+		if (!take(queueIndex, task))
+			return false;
+
+		--numPending;
+
+		runTask(task);
+
+		Batch& batch = *task.batch;
+		std::lock_guard lock(batch.doneMutex);
+		if (--batch.remaining == 0)
+			batch.done.notify_all();
+
+		return true;
+	}
+
+	void Pool::work(size_t queueIndex)
+	{
+		currentPool = this;
+		currentQueue = queueIndex;
+
+		while (true)
+		{
+			if (runOne(queueIndex))
+				continue;
+
+			std::unique_lock lock(sleepMutex);
+			wake.wait(lock, [this] { return stopping || numPending > 0; });
+			if (stopping)
+				return;
+		}
+	}
+
+	void Pool::run(Batch& batch, size_t count)
+	{
+		const size_t queueIndex = getQueueIndex();
+		batch.remaining = count;
+
+		// Deal the chunks out across every queue, last first, so that each
+		// thread starts on the lowest of its share and thieves take the
+		// highest. Chunks then start roughly in order and reductions fold
+		// as they go.
+		for (size_t chunk = count; chunk-- > 0; )
+		{
+			Queue& queue = *queues[(queueIndex + chunk) % queues.size()];
+			std::lock_guard lock(queue.mutex);
+			queue.tasks.push_back({&batch, chunk});
+		}
+
+		{
+			std::lock_guard lock(sleepMutex);
+			numPending += count;
+		}
+		wake.notify_all();
+
+		// Help with whatever is queued, then sleep until the chunks that
+		// others took have finished.
+		while (batch.remaining > 0 && runOne(queueIndex))
+		{
+		}
+
+		std::unique_lock lock(batch.doneMutex);
+		batch.done.wait(lock, [&batch] { return batch.remaining == 0; });
+	}
+
+	static std::atomic<unsigned> threadCount = 0;
+	static std::mutex poolMutex;
+	static std::unique_ptr<Pool> pool;
+
+	void setThreadCount(unsigned count)
+	{
+		std::lock_guard lock(poolMutex);
+		threadCount = count;
+		pool.reset();
+	}
+
+	void abandonPoolAfterFork(unsigned count)
+	{
+		// Its destructor would join threads that only exist in the parent.
+		[[maybe_unused]] Pool* const abandoned = pool.release();
+
+		if (count != 0)
+			threadCount = count;
+	}
+
+	unsigned getThreadCount()
+	{
+		const unsigned count = threadCount;
+		return count != 0 ? count : std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	static Pool* getPool()
+	{
+		std::lock_guard lock(poolMutex);
+		if (!pool && getThreadCount() > 1)
+			pool = std::make_unique<Pool>(getThreadCount());
+
+		return pool.get();
+	}
+
+	void runChunks(size_t count, const std::function<void(size_t)>& fn)
+	{
+		Pool* const threads = count > 1 ? getPool() : nullptr;
+		if (!threads)
+		{
+			for (size_t chunk = 0; chunk < count; ++chunk)
+				fn(chunk);
+
+			return;
+		}
+
+		Batch batch;
+		batch.fn = &fn;
+		batch.day = Days::currentDay();
+		batch.out = &Days::out();
+		batch.owner = std::this_thread::get_id();
+		threads->run(batch, count);
+
+		Alloc::receive(batch.allocs);
+		if (batch.perf)
+			Perf::receive(*batch.perf);
+	}
+}
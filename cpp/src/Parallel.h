@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Loops spread across a shared work-stealing thread pool, e.g.
+//
+//     const uint64_t sum = Parallel::reduce(0, data.equations.size(), 0ull,
+//         [&] (size_t i) { return canEvaluate(data.equations[i]) ? data.equations[i].total : 0; },
+//         std::plus<>());
+//
+// A range is cut into chunks that depend only on its size and the minimum
+// chunk size, never on how many threads there are, and reductions combine
+// the chunks' results in order, so every answer comes out the same however
+// the work was scheduled. A loop's chunks are dealt out across every
+// thread's queue. Each thread runs the newest chunk in its own queue and,
+// once that is empty, steals the oldest from another's. The thread waiting
+// on a loop runs chunks too (its own or other loops'), so loops can nest,
+// and sleeps once there are none left to take. Chunks run as the day that
+// started the loop (see Days::Scope), for out() and stats.
+
+namespace Parallel
+{
+	// How many threads loops use, counting the one waiting on them. 0 (the
+	// default) means one per core. Set it before any loop runs.
+	void setThreadCount(unsigned count);
+	unsigned getThreadCount();
+
+	// For the child of a fork(), which has none of the pool's threads: drops
+	// the pool without waiting on them, so that the next loop starts anew
+	// with threadCount threads (0 keeps the current count).
+	void abandonPoolAfterFork(unsigned threadCount = 0);
+
+	struct Chunks
+	{
+		size_t begin = 0;
+		size_t end = 0;
+		size_t size = 1; // of each chunk but the last
+		size_t count = 0;
+
+		Chunks(size_t begin, size_t end, size_t minChunkSize);
+
+		std::pair<size_t, size_t> get(size_t chunk) const
+		{
+			const size_t chunkBegin = begin + chunk * size;
+			return {chunkBegin, std::min(chunkBegin + size, end)};
+		}
+	};
+
+	// Calls fn(chunk) for every chunk in 0..count-1 across the pool and
+	// returns once they have all finished.
+	void runChunks(size_t count, const std::function<void(size_t)>& fn);
+
+	// Calls fn(chunkBegin, chunkEnd) for chunks covering [begin, end).
+	template <typename Fn>
+	void forEachChunk(size_t begin, size_t end, Fn&& fn, size_t minChunkSize = 1)
+	{
+		const Chunks chunks(begin, end, minChunkSize);
+		runChunks(chunks.count, [&] (size_t chunk)
+		{
+			const auto [chunkBegin, chunkEnd] = chunks.get(chunk);
+			fn(chunkBegin, chunkEnd);
+		});
+	}
+
+	// Calls fn(i) for every i in [begin, end).
+	template <typename Fn>
+	void forEach(size_t begin, size_t end, Fn&& fn, size_t minChunkSize = 1)
+	{
+		forEachChunk(begin, end, [&] (size_t chunkBegin, size_t chunkEnd)
+		{
+			for (size_t i = chunkBegin; i < chunkEnd; ++i)
+				fn(i);
+		}, minChunkSize);
+	}
+
+	// Folds fn(chunkBegin, chunkEnd) for chunks covering [begin, end) into
+	// identity with combine, in chunk order. A chunk's result is folded in
+	// as soon as those before it have been, so results are only held for
+	// chunks that finish early. For per-chunk state such as scratch buffers.
+	template <typename T, typename ChunkFn, typename Combine>
+	T reduceChunks(size_t begin, size_t end, T identity, ChunkFn&& fn, Combine&& combine, size_t minChunkSize = 1)
+	{
+		const Chunks chunks(begin, end, minChunkSize);
+
+		std::mutex mutex;
+		std::vector<std::optional<T>> results(chunks.count);
+		size_t numFolded = 0;
+		T total = std::move(identity);
+
+		runChunks(chunks.count, [&] (size_t chunk)
+		{
+			const auto [chunkBegin, chunkEnd] = chunks.get(chunk);
+			T result = fn(chunkBegin, chunkEnd);
+
+			std::lock_guard lock(mutex);
+			results[chunk] = std::move(result);
+
+			for (; numFolded < chunks.count && results[numFolded]; ++numFolded)
+			{
+				total = combine(std::move(total), std::move(*results[numFolded]));
+				results[numFolded].reset();
+			}
+		});
+
+		return total;
+	}
+
+	// Folds map(i) for every i in [begin, end) into identity with combine.
+	template <typename T, typename Map, typename Combine>
+	T reduce(size_t begin, size_t end, T identity, Map&& map, Combine&& combine, size_t minChunkSize = 1)
+	{
+		return reduceChunks(begin, end, identity, [&] (size_t chunkBegin, size_t chunkEnd)
+		{
+			T result = identity;
+			for (size_t i = chunkBegin; i < chunkEnd; ++i)
+				result = combine(std::move(result), map(i));
+
+			return result;
+		}, combine, minChunkSize);
+	}
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "BucketQueue.h"
+
+// Shortest paths over any graph whose states can be numbered 0..n-1, such as
+// grid positions or (position, direction) pairs. Costs, and predecessors if
+// they are kept, live in flat arrays indexed by that number, so a search
+// allocates nothing per state beyond its queue.
+//
+// A search is run with the moves out of each state given by a callback:
+//
+//     search.run<PathSearch::Mode::Dijkstra>(start,
+//         [&] (const State& state, auto&& visit) { visit(next, cost); ... },
+//         [&] (const State& state) { return state.pos == end; });
+
+namespace PathSearch
+{
+	enum class Mode
+	{
+		BreadthFirst, // every move costs 1
+		Dijkstra,
+		AStar, // Dijkstra led by a heuristic that never overestimates and is consistent
+	};
+
+	enum class QueueType
+	{
+		BinaryHeap,
+		Buckets, // Dial's algorithm, for small integer move costs (see setMaxMoveCost)
+	};
+
+	struct NoHeuristic
+	{
+		template <typename State>
+		int operator()(const State&) const { return 0; }
+	};
+
+	template <typename State, typename Cost, typename Index>
+	class Search
+	{
+	public:
+		static constexpr Cost unreached = std::numeric_limits<Cost>::max();
+
+		// With keepPredecessors, every cheapest way into each state is kept,
+		// not just one cost, so all the cheapest paths can be walked back.
+		Search(size_t numStates, Index index, bool keepPredecessors = false)
+			: index(index)
+			, keepPredecessors(keepPredecessors)
+			, costs(numStates, unreached)
+			, predecessors(keepPredecessors ? numStates : 0)
+		{
+		}
+
+		// The most that one move can raise the priority by: its cost, plus any
+		// rise in the heuristic for A*. Needed to size QueueType::Buckets.
+		void setMaxMoveCost(Cost cost) { maxMoveCost = cost; }
+
+		// Searches out from start until the cheapest goal is reached, or
+		// everything reachable has been, and returns the goal's cost.
+		// neighbours(state, visit) calls visit(next, moveCost) for each move.
+		// When keeping predecessors the search goes on until everything as
+		// cheap as the goal has been reached too, to find every path to it.
+		template <Mode mode, QueueType queueType = QueueType::BinaryHeap, typename Neighbours, typename IsGoal, typename Heuristic = NoHeuristic>
+		std::optional<Cost> run(const State& start, Neighbours&& neighbours, IsGoal&& isGoal, Heuristic&& heuristic = {})
+		{
+			std::fill(costs.begin(), costs.end(), unreached);
+			for (std::vector<State>& from : predecessors)
+				from.clear();
+
+			costs[index(start)] = 0;
+
+			if constexpr (mode == Mode::BreadthFirst)
+			{
+				return runBreadthFirst(start, neighbours, isGoal);
+			}
+			else if constexpr (queueType == QueueType::Buckets)
+			{
+				assert(maxMoveCost > 0);
+				BucketQueue<Entry, Cost> queue(maxMoveCost);
+				return runBestFirst<mode>(queue, start, neighbours, isGoal, heuristic);
+			}
+			else
+			{
+				HeapQueue<Entry, Cost> queue;
+				return runBestFirst<mode>(queue, start, neighbours, isGoal, heuristic);
+			}
+		}
+
+		Cost getCost(const State& state) const { return costs[index(state)]; }
+		bool isReached(const State& state) const { return getCost(state) != unreached; }
+
+		// Calls fn once for each state on any cheapest path from the start to
+		// the cheapest of ends, ends included. Needs keepPredecessors.
+		template <typename Fn>
+		void forEachOnCheapestPaths(const std::vector<State>& ends, Fn&& fn) const
+		{
+			assert(keepPredecessors);
+
+			Cost cheapest = unreached;
+			for (const State& end : ends)
+				cheapest = std::min(cheapest, getCost(end));
+
+			if (cheapest == unreached)
+				return;
+
+			std::vector<uint8_t> seen(costs.size(), false);
+			std::vector<State> stack;
+
+			for (const State& end : ends)
+				if (getCost(end) == cheapest && !std::exchange(seen[index(end)], true))
+					stack.push_back(end);
+
+			while (!stack.empty())
+			{
+				const State state = stack.back();
+				stack.pop_back();
+				fn(state);
+
+				for (const State& from : predecessors[index(state)])
+					if (!std::exchange(seen[index(from)], true))
+						stack.push_back(from);
+			}
+		}
+
+	private:
+		struct Entry
+		{
+			Cost cost;
+			State state;
+		};
+
+		bool relax(const State& from, Cost cost, const State& next)
+		{
+			Cost& nextCost = costs[index(next)];
+			if (cost < nextCost)
+			{
+				nextCost = cost;
+				if (keepPredecessors)
+					predecessors[index(next)].assign(1, from);
+				return true;
+			}
+
+			if (keepPredecessors && cost == nextCost)
+				predecessors[index(next)].push_back(from);
+
+			return false;
+		}
+
+		template <typename Neighbours, typename IsGoal>
+		std::optional<Cost> runBreadthFirst(const State& start, Neighbours& neighbours, IsGoal& isGoal)
+		{
+			std::optional<Cost> goalCost;
+			std::vector<State> queue = {start};
+
+			for (size_t head = 0; head < queue.size(); ++head)
+			{
+				const State state = queue[head];
+				const Cost cost = costs[index(state)];
+
+				if (goalCost && cost > *goalCost)
+					break;
+
+				if (!goalCost && isGoal(state))
+				{
+					goalCost = cost;
+					if (!keepPredecessors)
+						break;
+				}
+
+				neighbours(state, [&] (const State& next, [[maybe_unused]] Cost moveCost)
+				{
+					assert(moveCost == 1);
+					if (relax(state, cost + 1, next))
+						queue.push_back(next);
+				});
+			}
+
+			return goalCost;
+		}
+
+		template <Mode mode, typename Queue, typename Neighbours, typename IsGoal, typename Heuristic>
+		std::optional<Cost> runBestFirst(Queue& queue, const State& start, Neighbours& neighbours, IsGoal& isGoal, Heuristic& heuristic)
+		{
+			std::optional<Cost> goalCost;
+			queue.push(getPriority<mode>(0, start, heuristic), {0, start});
+
+			while (!queue.empty())
+			{
+				const std::pair<Cost, Entry> top = queue.pop();
+				const Cost priority = top.first;
+				const Entry& entry = top.second;
+
+				if (entry.cost > costs[index(entry.state)])
+					continue; // a cheaper way here was found after this was queued
+
+				if (goalCost && priority > *goalCost)
+					break;
+
+				if (!goalCost && isGoal(entry.state))
+				{
+					goalCost = entry.cost;
+					if (!keepPredecessors)
+						break;
+				}
+
+				neighbours(entry.state, [&] (const State& next, Cost moveCost)
+				{
+					const Cost cost = entry.cost + moveCost;
+					if (relax(entry.state, cost, next))
+						queue.push(getPriority<mode>(cost, next, heuristic), {cost, next});
+				});
+			}
+
+			return goalCost;
+		}
+
+		template <Mode mode, typename Heuristic>
+		static Cost getPriority(Cost cost, const State& state, Heuristic& heuristic)
+		{
+			if constexpr (mode == Mode::AStar)
+				return cost + (Cost) heuristic(state);
+			else
+				return cost;
+		}
+
+		Index index;
+		bool keepPredecessors = false;
+		Cost maxMoveCost = 0;
+		std::vector<Cost> costs;
+		std::vector<std::vector<State>> predecessors;
+	};
+
+	// Search<State, Cost> numbering states with index(state), which must be
+	// less than numStates.
+	template <typename State, typename Cost = int, typename Index>
+	Search<State, Cost, Index> makeSearch(size_t numStates, Index index, bool keepPredecessors = false)
+	{
+		return Search<State, Cost, Index>(numStates, index, keepPredecessors);
+	}
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Parses a line against a format that is fixed at compile time, decoding
+// each {} straight into the next field, e.g.
+//
+//     Pattern::match<"p={},{} v={},{}">(line, r.pos.x, r.pos.y, r.vel.x, r.vel.y)
+//
+// The literal text between fields must match exactly, and so must the whole
+// line. Integer fields are read with from_chars (a leading '-' is allowed
+// for signed types). A std::string or std::string_view field takes
+// everything up to the first character of the literal that follows it, or
+// the rest of the line. The pattern is split up at compile time, where it is
+// also checked against the number of fields, so matching is a single pass
+// over the line.
+
+namespace Pattern
+{
+	template <size_t N>
+	struct Text
+	{
+		char chars[N] = {};
+
+		constexpr Text(const char (&text)[N]) { std::copy_n(text, N, chars); }
+
+		constexpr std::string_view view() const { return {chars, N - 1}; }
+	};
+
+	// The number of {} fields, or -1 if a brace is unpaired or two fields have
+	// nothing between them to tell where the first ends.
+	constexpr int countFields(std::string_view pattern)
+	{
+		int count = 0;
+
+		for (size_t i = 0; i < pattern.size(); ++i)
+		{
+			if (pattern[i] == '}')
+				return -1;
+
+			if (pattern[i] != '{')
+				continue;
+
+			if (i + 1 == pattern.size() || pattern[i + 1] != '}')
+				return -1;
+
+			if (i + 2 < pattern.size() && pattern[i + 2] == '{')
+				return -1;
+
+			++count;
+			++i;
+		}
+
+		return count;
+	}
+
+	struct Literal
+	{
+		size_t start = 0;
+		size_t size = 0;
+	};
+
+	// Where in the pattern the literal text before each field, and after the
+	// last one, lies.
+	template <Text pattern>
+	constexpr auto getLiterals()
+	{
+		constexpr std::string_view format = pattern.view();
+		std::array<Literal, countFields(format) + 1> literals{};
+
+		size_t start = 0;
+		size_t field = 0;
+
+		for (size_t i = 0; i < format.size(); ++i)
+		{
+			if (format[i] == '{')
+			{
+				literals[field++] = {start, i - start};
+				start = i + 2;
+				++i;
+			}
+		}
+
+		literals[field] = {start, format.size() - start};
+		return literals;
+	}
+
+	template <typename T>
+	bool parseField(const char*& cursor, const char* end, char terminator, T& value)
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			static_assert(!std::is_same_v<T, char> && !std::is_same_v<T, bool>, "Pattern fields of this type are not supported");
+
+			const std::from_chars_result result = std::from_chars(cursor, end, value);
+			if (result.ec != std::errc())
+				return false;
+
+			cursor = result.ptr;
+			return true;
+		}
+		else
+		{
+			static_assert(std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>, "Pattern fields of this type are not supported");
+
+			const char* start = cursor;
+			while (cursor != end && *cursor != terminator)
+				++cursor;
+
+			value = T(start, cursor - start);
+			return true;
+		}
+	}
+
+	template <Text pattern, typename... Fields>
+	bool match(std::string_view line, Fields&... fields)
+	{
+		constexpr std::string_view format = pattern.view();
+		static_assert(countFields(format) >= 0, "Pattern has an unpaired brace or two {} with nothing between them");
+		static_assert(countFields(format) == sizeof...(Fields), "Pattern needs one {} for each field");
+
+		static constexpr std::array<Literal, sizeof...(Fields) + 1> literals = getLiterals<pattern>();
+
+		const char* cursor = line.data();
+		const char* const end = cursor + line.size();
+
+		auto matchLiteral = [&] (const Literal& literal)
+		{
+			if ((size_t) (end - cursor) < literal.size || format.substr(literal.start, literal.size) != std::string_view(cursor, literal.size))
+				return false;
+
+			cursor += literal.size;
+			return true;
+		};
+
+		// A string field ends where the next literal begins, or at the end of the line.
+		auto getTerminator = [&] (size_t field)
+		{
+			const Literal& next = literals[field + 1];
+			return next.size > 0 ? format[next.start] : '\0';
+		};
+
+		size_t field = 0;
+
+		const bool matchedFields = ((matchLiteral(literals[field]) && parseField(cursor, end, getTerminator(field), fields) && (++field, true)) && ...);
+
+		return matchedFields && matchLiteral(literals[sizeof...(Fields)]) && cursor == end;
+	}
+}
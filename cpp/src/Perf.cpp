@@ -0,0 +1,237 @@
+#include "Perf.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Perf
+{
+	static std::atomic<bool> enabled = false;
+
+	// Events handed to this thread by others less those it handed off, which
+	// Scopes add to what the counters read.
+	static thread_local int64_t transferred[EventCount] = {};
+
+	void setEnabled(bool value)
+	{
+		enabled = value;
+	}
+
+	bool isEnabled()
+	{
+		return enabled;
+	}
+
+	const char* getEventName(Event event)
+	{
+		switch (event)
+		{
+		case Cycles: return "cycles";
+		case Instructions: return "instructions";
+		case L1DMisses: return "l1dMisses";
+		case LLCMisses: return "llcMisses";
+		case BranchMisses: return "branchMisses";
+		default: return "?";
+		}
+	}
+
+	bool Counts::any() const
+	{
+		for (bool v : valid)
+			if (v)
+				return true;
+		return false;
+	}
+
+	double Counts::ipc() const
+	{
+		if (!valid[Cycles] || !valid[Instructions] || values[Cycles] == 0)
+			return 0.0;
+		return (double) values[Instructions] / values[Cycles];
+	}
+
+	void Counts::add(const Counts& other)
+	{
+		for (int event = 0; event < EventCount; ++event)
+		{
+			values[event] += other.values[event];
+			valid[event] = valid[event] && other.valid[event];
+		}
+	}
+
+	Counts Scope::finish()
+	{
+		Counts counts = readCounters();
+		for (int event = 0; event < EventCount; ++event)
+		{
+			const int64_t adjusted = (int64_t) counts.values[event] + transferred[event] - startTransferred[event];
+			counts.values[event] = (uint64_t) std::max<int64_t>(0, adjusted);
+		}
+		return counts;
+	}
+
+	Counts HandoffScope::finish()
+	{
+		const Counts counts = scope.finish();
+		for (int event = 0; event < EventCount; ++event)
+			transferred[event] -= (int64_t) counts.values[event];
+		return counts;
+	}
+
+	void receive(const Counts& counts)
+	{
+		for (int event = 0; event < EventCount; ++event)
+			if (counts.valid[event])
+				transferred[event] += (int64_t) counts.values[event];
+	}
+
+	std::ostream& operator<<(std::ostream& out, const Counts& counts)
+	{
+		if (!counts.any())
+			return out << "perf counters unavailable";
+
+		const std::ios::fmtflags flags = out.flags();
+		const std::streamsize precision = out.precision();
+
+		const char* separator = "";
+		for (int event = 0; event < EventCount; ++event)
+		{
+			out << separator << getEventName((Event) event) << ' ';
+			if (counts.valid[event])
+				out << counts.values[event];
+			else
+				out << '-';
+			separator = ", ";
+		}
+
+		if (counts.valid[Cycles] && counts.valid[Instructions])
+			out << ", ipc " << std::fixed << std::setprecision(2) << counts.ipc();
+
+		out.flags(flags);
+		out.precision(precision);
+		return out;
+	}
+
+#ifdef __linux__
+	static int openCounter(uint32_t type, uint64_t config)
+	{
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = type;
+		attr.config = config;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1; // also what an unprivileged user is allowed to count
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		// This thread, on whichever CPU it runs.
+		return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+	}
+
+	static constexpr uint64_t cacheReadMiss(uint64_t cache)
+	{
+		return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	}
+
+	static void warnUnavailable()
+	{
+		static std::atomic<bool> warned = false;
+		if (!warned.exchange(true))
+		{
+			// ENOENT: no hardware PMU (common in VMs); EACCES/EPERM: see
+			// /proc/sys/kernel/perf_event_paranoid.
+			std::cerr << "perf counters unavailable: perf_event_open failed (" << std::strerror(errno) << ")" << std::endl;
+		}
+	}
+
+	Scope::Scope()
+	{
+		std::copy(std::begin(transferred), std::end(transferred), startTransferred);
+
+		fds[Cycles] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+		fds[Instructions] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+		fds[L1DMisses] = openCounter(PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_L1D));
+		fds[LLCMisses] = openCounter(PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_LL));
+		fds[BranchMisses] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+
+		bool anyOpen = false;
+		for (int fd : fds)
+			anyOpen |= fd >= 0;
+
+		if (!anyOpen)
+			warnUnavailable();
+
+		// Separate groups rather than one, so that an event the CPU lacks doesn't
+		// take the others down with it; enable them back to back to keep the
+		// windows as close as possible.
+		for (int fd : fds)
+			if (fd >= 0)
+				ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+		for (int fd : fds)
+			if (fd >= 0)
+				ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+
+	Scope::~Scope()
+	{
+		for (int& fd : fds)
+		{
+			if (fd >= 0)
+				close(fd);
+			fd = -1;
+		}
+	}
+
+	Counts Scope::readCounters()
+	{
+		for (int fd : fds)
+			if (fd >= 0)
+				ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+		Counts counts;
+		for (int event = 0; event < EventCount; ++event)
+		{
+			if (fds[event] < 0)
+				continue;
+
+			struct { uint64_t value, timeEnabled, timeRunning; } reading;
+			if (read(fds[event], &reading, sizeof(reading)) != (ssize_t) sizeof(reading) || reading.timeRunning == 0)
+				continue;
+
+			// Multiplexed counters only ran for part of the window; extrapolate.
+			counts.values[event] = reading.timeRunning < reading.timeEnabled
+				? (uint64_t) ((double) reading.value * reading.timeEnabled / reading.timeRunning)
+				: reading.value;
+			counts.valid[event] = true;
+		}
+		return counts;
+	}
+#else
+	Scope::Scope()
+	{
+		std::copy(std::begin(transferred), std::end(transferred), startTransferred);
+
+		for (int& fd : fds)
+			fd = -1;
+	}
+
+	Scope::~Scope() = default;
+
+	Counts Scope::readCounters()
+	{
+		return {};
+	}
+#endif
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+
+// Hardware performance counters for the load/part phases, read through
+// perf_event_open on Linux. Enabled at runtime with --perf; on other platforms,
+// or where the kernel refuses access (see /proc/sys/kernel/perf_event_paranoid),
+// every counter reads as unavailable.
+
+namespace Perf
+{
+	enum Event
+	{
+		Cycles,
+		Instructions,
+		L1DMisses,
+		LLCMisses,
+		BranchMisses,
+
+		EventCount
+	};
+
+	const char* getEventName(Event event);
+
+	struct Counts
+	{
+		uint64_t values[EventCount] = {};
+		bool valid[EventCount] = {};
+
+		bool any() const;
+		double ipc() const;
+
+		// Adds other's counts, as if its work had been done here too. A count
+		// stays valid only if it was valid in both.
+		void add(const Counts& other);
+	};
+
+	void setEnabled(bool enabled);
+	bool isEnabled();
+
+	// Counts events on this thread between construction and finish(). Each
+	// counter is scaled up if the kernel had to multiplex it with others.
+	class Scope
+	{
+	public:
+		Scope();
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+		Counts finish();
+
+	private:
+		Counts readCounters();
+
+		int fds[EventCount];
+		int64_t startTransferred[EventCount];
+	};
+
+	// Counts the events of work this thread does for another, such as a
+	// Parallel chunk, and takes them off this thread's own Scopes. The thread
+	// the work was done for adds them to its Scopes with receive().
+	class HandoffScope
+	{
+	public:
+		Counts finish();
+
+	private:
+		Scope scope;
+	};
+
+	void receive(const Counts& counts);
+
+	template <typename Fn>
+	decltype(auto) track(Counts& counts, Fn&& fn)
+	{
+		if (!isEnabled())
+			return fn();
+
+		Scope scope;
+		decltype(auto) result = fn();
+		counts = scope.finish();
+		return result;
+	}
+
+	std::ostream& operator<<(std::ostream& out, const Counts& counts);
+}
@@ -0,0 +1,187 @@
+#include "Recording.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "Days.h"
+#include "MappedFile.h"
+#include "Renderer.h"
+
+namespace Recording
+{
+	static const char magic[4] = {'A', 'O', 'C', 'R'};
+	static constexpr uint64_t formatVersion = 1;
+
+	static std::string directory;
+
+	void setDirectory(const std::string& value)
+	{
+		directory = value;
+	}
+
+	bool isEnabled()
+	{
+		return !directory.empty();
+	}
+
+	static void writeVarint(std::string& out, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			out += (char) ((value & 0x7f) | 0x80);
+			value >>= 7;
+		}
+		out += (char) value;
+	}
+
+	static bool readVarint(const char*& cursor, const char* end, uint64_t& value)
+	{
+		value = 0;
+		for (int shift = 0; cursor != end && shift < 64; shift += 7)
+		{
+			const uint8_t byte = (uint8_t) *cursor++;
+			value |= (uint64_t) (byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+
+	static std::string getNextFilename()
+	{
+		// Counted per day so that the names don't depend on what else ran.
+		static std::atomic<int> counts[32];
+
+		const int day = Days::currentDay();
+		const int count = ++counts[(size_t) day % std::size(counts)];
+
+		std::ostringstream name;
+		name << directory << "/day" << std::setw(2) << std::setfill('0') << day << '-' << count << ".rec";
+		return name.str();
+	}
+
+	Writer::Writer(size_t width, size_t height)
+		: width(width)
+		, height(height)
+		, filename(getNextFilename())
+		, file(filename, std::ios::binary)
+		, previous(height, std::string(width, ' '))
+	{
+		std::string header(magic, sizeof(magic));
+		writeVarint(header, formatVersion);
+		writeVarint(header, width);
+		writeVarint(header, height);
+		file.write(header.data(), header.size());
+	}
+
+	void Writer::addFrame(const std::vector<std::string>& frame)
+	{
+		encoded.clear();
+		uint64_t skipped = 0;
+
+		for (size_t y = 0; y < height; ++y)
+		{
+			const std::string& line = frame[y];
+			std::string& before = previous[y];
+
+			for (size_t x = 0; x < width; )
+			{
+				if (line[x] == before[x])
+				{
+					++skipped;
+					++x;
+					continue;
+				}
+
+				const char c = line[x];
+				const size_t start = x;
+				while (x < width && line[x] == c && before[x] != c)
+					++x;
+
+				writeVarint(encoded, skipped);
+				writeVarint(encoded, x - start);
+				encoded += c;
+				skipped = 0;
+			}
+
+			before = line;
+		}
+
+		std::string size;
+		writeVarint(size, encoded.size());
+		file.write(size.data(), size.size());
+		file.write(encoded.data(), encoded.size());
+	}
+
+	bool play(const char* filename, double framesPerSecond)
+	{
+		const MappedFile recording(filename);
+		if (!recording.isOpen() || recording.size() < sizeof(magic) || std::memcmp(recording.data(), magic, sizeof(magic)) != 0)
+			return false;
+
+		const char* cursor = recording.data() + sizeof(magic);
+		const char* const end = recording.data() + recording.size();
+
+		uint64_t version = 0;
+		uint64_t width = 0;
+		uint64_t height = 0;
+		if (!readVarint(cursor, end, version) || version != formatVersion
+			|| !readVarint(cursor, end, width)
+			|| !readVarint(cursor, end, height))
+			return false;
+
+		using Clock = std::chrono::steady_clock;
+		const auto frameTime = std::chrono::duration_cast<Clock::duration>(
+			std::chrono::duration<double>(framesPerSecond > 0.0 ? 1.0 / framesPerSecond : 0.0));
+
+		Terminal::enableEscapes();
+		std::cout << "\x1b[2J";
+
+		std::vector<std::string> frame(height, std::string(width, ' '));
+		std::vector<std::string> shown;
+		std::string out;
+		Clock::time_point nextFrame = Clock::now();
+
+		for (int iteration = 1; cursor != end; ++iteration)
+		{
+			uint64_t size = 0;
+			if (!readVarint(cursor, end, size) || size > (uint64_t) (end - cursor))
+				return false;
+
+			const char* const frameEnd = cursor + size;
+			uint64_t cell = 0;
+
+			while (cursor != frameEnd)
+			{
+				uint64_t skipped = 0;
+				uint64_t length = 0;
+				if (!readVarint(cursor, frameEnd, skipped) || !readVarint(cursor, frameEnd, length) || cursor == frameEnd)
+					return false;
+
+				const char c = *cursor++;
+				cell += skipped;
+				if (cell + length > width * height)
+					return false;
+
+				for (; length > 0; --length, ++cell)
+					frame[cell / width][cell % width] = c;
+			}
+
+			out.clear();
+			Terminal::drawFrame(out, frame, shown, iteration);
+			shown = frame;
+
+			std::this_thread::sleep_until(nextFrame);
+			std::cout.write(out.data(), out.size());
+			std::cout.flush();
+			nextFrame += frameTime;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Renderer frames saved to a file instead of drawn, so that a solver can run
+// at full speed and its animation be watched afterwards with --play.
+//
+// A recording starts with "AOCR", a format version and the frame's width and
+// height. Each frame follows as its encoded size and then the cells that
+// changed since the previous frame (the first is compared against a blank
+// one), read row by row: repeated (unchanged cells to skip, run length,
+// character) triples, each run being the same character. All numbers are
+// LEB128 varints.
+
+namespace Recording
+{
+	// Where renderers write their recordings, one file per renderer named
+	// dayNN-n.rec. Empty (the default) means draw to the screen as usual.
+	void setDirectory(const std::string& directory);
+	bool isEnabled();
+
+	class Writer
+	{
+	public:
+		// Opens a new recording for the day running on this thread.
+		Writer(size_t width, size_t height);
+
+		bool isOpen() const { return file.is_open(); }
+		const std::string& getFilename() const { return filename; }
+
+		void addFrame(const std::vector<std::string>& frame);
+
+	private:
+		const size_t width;
+		const size_t height;
+		std::string filename;
+		std::ofstream file;
+		std::vector<std::string> previous;
+		std::string encoded;
+	};
+
+	// Replays a recording on the terminal. A framesPerSecond of 0 shows every
+	// frame as fast as the terminal will take it.
+	bool play(const char* filename, double framesPerSecond);
+}
@@ -1,10 +1,85 @@
 #include "Renderer.h"
 
-#include "Windows.h"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 #include <thread>
 
+namespace Terminal
+{
+	void enableEscapes()
+	{
+#ifdef _WIN32
+		HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+		DWORD mode = 0;
+		if (GetConsoleMode(output, &mode))
+			SetConsoleMode(output, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+
+		SetConsoleScreenBufferSize(output, {200, 200});
+#endif
+	}
+
+	static void moveCursor(std::string& out, size_t row, size_t column)
+	{
+		out += "\x1b[";
+		out += std::to_string(row + 1);
+		out += ';';
+		out += std::to_string(column + 1);
+		out += 'H';
+	}
+
+	void drawFrame(std::string& out, const std::vector<std::string>& frame, const std::vector<std::string>& shown, int iteration)
+	{
+		moveCursor(out, 0, 0);
+		out += "Iteration: ";
+		out += std::to_string(iteration);
+		out += "\x1b[K\n";
+
+		if (shown.empty())
+		{
+			for (const std::string& line : frame)
+			{
+				out += line;
+				out += '\n';
+			}
+			return;
+		}
+
+		// The frame starts on the row below the iteration number.
+		for (size_t y = 0; y < frame.size(); ++y)
+		{
+			const std::string& line = frame[y];
+			const std::string& onScreen = shown[y];
+
+			for (size_t x = 0; x < line.size(); )
+			{
+				if (line[x] == onScreen[x])
+				{
+					++x;
+					continue;
+				}
+
+				const size_t start = x;
+				while (x < line.size() && line[x] != onScreen[x])
+					++x;
+
+				moveCursor(out, y + 1, start);
+				out.append(line, start, x - start);
+			}
+		}
+
+		moveCursor(out, frame.size() + 1, 0);
+	}
+}
+
+#ifdef AOC_RENDER
+
 Renderer::Renderer(const Bounds& bounds)
 	: Renderer(bounds.botRght.x, bounds.botRght.y)
 {
@@ -13,22 +88,36 @@ Renderer::Renderer(const Bounds& bounds)
 Renderer::Renderer(size_t width, size_t height)
 	: width(width)
 	, height(height)
-	, emptyGrid(height, std::string(width, ' '))
+	, buffer(height, std::string(width, ' '))
 {
-	HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
-	SetConsoleScreenBufferSize(output, {200, 200});
-
-	clear();
+	if (Recording::isEnabled())
+	{
+		recording = std::make_unique<Recording::Writer>(width, height);
+		if (!recording->isOpen())
+		{
+			std::cerr << "Could not record to " << recording->getFilename() << std::endl;
+			recording.reset();
+		}
+	}
+	else
+	{
+		Terminal::enableEscapes();
+	}
 }
 
 void Renderer::clear()
 {
-	buffer = emptyGrid;
+	for (std::string& line : buffer)
+		std::fill(line.begin(), line.end(), ' ');
 }
 
 void Renderer::clearScreen()
 {
-	system("cls");
+	if (recording)
+		return;
+
+	std::cout << "\x1b[2J\x1b[H" << std::flush;
+	shown.clear();
 }
 
 void Renderer::plot(Vec2 pos, char c)
@@ -38,37 +127,53 @@ void Renderer::plot(Vec2 pos, char c)
 
 void Renderer::render(bool resetPos)
 {
-	if (resetPos)
+	++iteration;
+
+	if (recording)
 	{
-		COORD pos = {0, 0};
-		static HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
-		SetConsoleCursorPosition(output, pos);
+		recording->addFrame(buffer);
+		return;
 	}
 
-	++iteration;
-	std::cout << "Iteration: " << iteration << '\n';
+	std::string frame;
+	frame.reserve((width + 1) * (height + 1));
 
-	for (auto& line : buffer)
-		std::cout << line << '\n';
-}
+	if (resetPos)
+	{
+		Terminal::drawFrame(frame, buffer, shown, iteration);
+		shown = buffer;
+	}
+	else
+	{
+		frame += "Iteration: ";
+		frame += std::to_string(iteration);
+		frame += '\n';
 
-std::string Renderer::concatenated() const
-{
-	std::string concat;
+		for (const std::string& line : buffer)
+		{
+			frame += line;
+			frame += '\n';
+		}
 
-	for (auto& line : buffer)
-		concat += line;
+		shown.clear();
+	}
 
-	return concat;
+	std::cout.write(frame.data(), frame.size());
+	std::cout.flush();
 }
 
 int Renderer::waitForInput()
 {
-	return std::cin.get();
+	return recording ? 0 : std::cin.get();
 }
 
 void Renderer::sleep(int milliseconds)
 {
+	if (recording)
+		return;
+
 	const std::chrono::duration<int, std::milli> duration{milliseconds};
 	std::this_thread::sleep_for(duration);
 }
+
+#endif
@@ -5,9 +5,38 @@
 
 #include "Vec2.h"
 
+#ifdef AOC_RENDER
+#include <memory>
+
+#include "Recording.h"
+#endif
+
+// Draws a character grid to the terminal so that a solver can be watched as
+// it works. Only builds with AOC_RENDER defined draw anything; otherwise
+// Renderer does nothing and its calls compile away, so days can leave their
+// drawing code in place without paying for it.
+//
+// With a recording directory set (--record), frames go to a file instead of
+// the screen and sleep() and waitForInput() return at once; see Recording.h.
+
+namespace Terminal
+{
+	// Lets the console interpret escape sequences, where it needs asking.
+	void enableEscapes();
+
+	// Appends the escape sequences that draw frame at the top of the screen,
+	// below its iteration number. Only the cells that differ from shown are
+	// written, unless shown is empty (the screen's contents are not known).
+	void drawFrame(std::string& out, const std::vector<std::string>& frame, const std::vector<std::string>& shown, int iteration);
+}
+
+#ifdef AOC_RENDER
+
 class Renderer
 {
 public:
+	static constexpr bool isEnabled = true;
+
 	explicit Renderer(const Bounds& bounds);
 	Renderer(size_t width, size_t height);
 
@@ -16,18 +45,46 @@ public:
 
 	void plot(Vec2 pos, char c);
 
+	// Redraws the frame at the top of the screen, writing only the cells that
+	// changed since this renderer's last frame. With resetPos false the whole
+	// frame is printed wherever the cursor is instead.
 	void render(bool resetPos = true);
 
 	int waitForInput();
 	void sleep(int milliseconds);
 
-	std::string concatenated() const;
-	const std::vector<std::string>& getBuffer() const { return buffer; }
+	bool isRecording() const { return recording != nullptr; }
 
 private:
 	const size_t width;
 	const size_t height;
-	std::vector<std::string> emptyGrid;
 	std::vector<std::string> buffer;
+	std::vector<std::string> shown; // what is on screen, empty if not known
 	int iteration = 0;
-};
\ No newline at end of file
+	std::unique_ptr<Recording::Writer> recording;
+};
+
+#else
+
+class Renderer
+{
+public:
+	static constexpr bool isEnabled = false;
+
+	explicit Renderer(const Bounds&) {}
+	Renderer(size_t, size_t) {}
+
+	void clear() {}
+	void clearScreen() {}
+
+	void plot(Vec2, char) {}
+
+	void render(bool = true) {}
+
+	int waitForInput() { return 0; }
+	void sleep(int) {}
+
+	bool isRecording() const { return false; }
+};
+
+#endif
@@ -0,0 +1,339 @@
+#include "Service.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "Days.h"
+#include "Harness.h"
+#include "Parallel.h"
+#include "Stats.h"
+
+namespace Service
+{
+	static std::atomic<double> timeoutSeconds = 60.0;
+
+	void setTimeout(double seconds)
+	{
+		timeoutSeconds = seconds;
+	}
+
+	static void warmUp()
+	{
+		for (const Days::Day& day : Days::getAll())
+		{
+			if (!day.warmer)
+				continue;
+
+			std::ostringstream discarded;
+			Days::Scope scope(day.number, discarded);
+			day.warmer();
+
+			// Requests should only count their own work, not the warm-up's.
+			Stats::reset(day.number);
+		}
+	}
+
+#ifndef _WIN32
+	static bool writeAll(int fd, const std::string& text)
+	{
+		for (size_t written = 0; written < text.size(); )
+		{
+			const ssize_t numWritten = write(fd, text.data() + written, text.size() - written);
+			if (numWritten <= 0)
+				return false;
+
+			written += (size_t) numWritten;
+		}
+
+		return true;
+	}
+#endif
+
+	// Solves the request on this thread and returns the day's output, with
+	// its stats. Leaves nothing behind for the next request.
+	static std::string solve(const Days::Day& day, const std::string& filename)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		std::ostringstream buffer;
+		{
+			Days::Scope scope(day.number, buffer);
+
+			const Clock::time_point start = Clock::now();
+			Days::solve(day.number, filename.c_str());
+			const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+			Stats::printSummary(buffer, day.number, seconds);
+		}
+
+		Harness::clearBenchmarkResults();
+		return buffer.str();
+	}
+
+	std::string solveContained(const Days::Day& day, const std::string& filename, std::string& output, [[maybe_unused]] unsigned threadCount)
+	{
+#ifndef _WIN32
+		// Batches call this from several threads at once. A child forked on
+		// one would inherit the write end of another's pipe while it's open
+		// here, and that pipe would then not reach EOF until the unrelated
+		// child exited too. So no fork happens while a write end is open.
+		static std::mutex forkMutex;
+		std::unique_lock forkLock(forkMutex);
+
+		int fds[2];
+		if (pipe(fds) != 0)
+			return "could not create a pipe";
+
+		std::cout.flush();
+		std::cerr.flush();
+
+		const pid_t pid = fork();
+		if (pid < 0)
+		{
+			close(fds[0]);
+			close(fds[1]);
+			return "could not fork";
+		}
+
+		if (pid == 0)
+		{
+			close(fds[0]);
+			Parallel::abandonPoolAfterFork(threadCount);
+
+			const bool written = writeAll(fds[1], solve(day, filename));
+			close(fds[1]);
+			_exit(written ? 0 : 1);
+		}
+
+		close(fds[1]);
+		forkLock.unlock();
+
+		// Reads until the child closes its end, unless it runs past the
+		// deadline, in which case it's killed so a solver that never returns
+		// can't hold up the requests behind it.
+		using Clock = std::chrono::steady_clock;
+		const double timeout = timeoutSeconds;
+		const Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeout));
+		bool timedOut = false;
+
+		while (true)
+		{
+			int waitMilliseconds = -1;
+			if (timeout > 0.0)
+			{
+				const auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count();
+				if (left <= 0)
+				{
+					timedOut = true;
+					break;
+				}
+
+				waitMilliseconds = (int) std::min<decltype(left)>(left, INT_MAX);
+			}
+
+			pollfd readable = {fds[0], POLLIN, 0};
+			const int ready = poll(&readable, 1, waitMilliseconds);
+			if (ready < 0 && errno == EINTR)
+				continue;
+
+			if (ready == 0)
+			{
+				timedOut = true;
+				break;
+			}
+
+			char chunk[4096];
+			const ssize_t numRead = ready > 0 ? read(fds[0], chunk, sizeof(chunk)) : -1;
+			if (numRead <= 0)
+				break;
+
+			output.append(chunk, (size_t) numRead);
+		}
+
+		close(fds[0]);
+
+		if (timedOut)
+			kill(pid, SIGKILL);
+
+		int status = 0;
+		if (waitpid(pid, &status, 0) != pid)
+			return "lost the solver process";
+
+		if (timedOut)
+			return "solver timed out";
+
+		if (WIFSIGNALED(status))
+			return std::string("solver died (") + strsignal(WTERMSIG(status)) + ")";
+
+		if (WEXITSTATUS(status) != 0)
+			return "solver exited with status " + std::to_string(WEXITSTATUS(status));
+
+		return {};
+#else
+		output = solve(day, filename);
+		return {};
+#endif
+	}
+
+	// False once the client has asked to stop.
+	static bool answer(const std::string& request, std::ostream& out)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		if (request == "quit")
+			return false;
+
+		if (request.empty())
+			return true;
+
+		std::istringstream fields(request);
+		int dayNumber = 0;
+		std::string filename;
+
+		fields >> dayNumber;
+		std::getline(fields >> std::ws, filename);
+
+		const Days::Day* day = Days::find(dayNumber);
+		std::error_code error;
+
+		if (!day || !day->solver)
+		{
+			out << "error no solver for \"" << request << "\"" << std::endl;
+			return true;
+		}
+
+		if (!std::filesystem::is_regular_file(filename, error))
+		{
+			out << "error no such file " << filename << std::endl;
+			return true;
+		}
+
+		if (std::filesystem::file_size(filename, error) == 0 || error)
+		{
+			out << "error empty input " << filename << std::endl;
+			return true;
+		}
+
+		std::string output;
+		const Clock::time_point start = Clock::now();
+		const std::string failure = solveContained(*day, filename, output);
+		const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		if (failure.empty())
+			out << output << "ok " << seconds << std::endl;
+		else
+			out << "error " << failure << std::endl;
+
+		return true;
+	}
+
+	static void answerAll(std::istream& in, std::ostream& out)
+	{
+		std::string request;
+		while (std::getline(in, request) && answer(request, out))
+		{
+		}
+	}
+
+	void serve(std::istream& in, std::ostream& out)
+	{
+		warmUp();
+		answerAll(in, out);
+	}
+
+#ifndef _WIN32
+	// Reads a connection's requests one line at a time, answering each before
+	// reading the next, so a client can wait on each answer.
+	static void serveConnection(int fd)
+	{
+		std::string pending;
+		char chunk[4096];
+
+		while (true)
+		{
+			size_t newline;
+			while ((newline = pending.find('\n')) == std::string::npos)
+			{
+				const ssize_t numRead = read(fd, chunk, sizeof(chunk));
+				if (numRead <= 0)
+					return;
+
+				pending.append(chunk, (size_t) numRead);
+			}
+
+			const std::string request = pending.substr(0, newline);
+			pending.erase(0, newline + 1);
+
+			std::ostringstream response;
+			const bool more = answer(request, response);
+
+			if (!writeAll(fd, response.str()))
+				return;
+
+			if (!more)
+				return;
+		}
+	}
+
+	bool serveSocket(const char* path)
+	{
+		sockaddr_un address = {};
+		address.sun_family = AF_UNIX;
+		if (std::string(path).size() >= sizeof(address.sun_path))
+			return false;
+
+		std::string(path).copy(address.sun_path, sizeof(address.sun_path) - 1);
+
+		const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listener < 0)
+			return false;
+
+		unlink(path);
+		if (bind(listener, (const sockaddr*) &address, sizeof(address)) != 0 || listen(listener, 8) != 0)
+		{
+			close(listener);
+			return false;
+		}
+
+		warmUp();
+		std::cerr << "Listening on " << path << std::endl;
+
+		while (true)
+		{
+			const int connection = accept(listener, nullptr, nullptr);
+			if (connection < 0)
+				break;
+
+			serveConnection(connection);
+			close(connection);
+		}
+
+		close(listener);
+		unlink(path);
+		return true;
+	}
+#else
+	bool serveSocket(const char*)
+	{
+		return false;
+	}
+#endif
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+
+namespace Days
+{
+	struct Day;
+}
+
+// Keeps one process resident to solve inputs on request, so that callers
+// don't pay for process start or rebuild the tables days keep between runs
+// (such as day 11's stone counts and day 21's keypad moves). Those are warmed
+// up front by each day's Warmer.
+//
+// Requests are lines of "<day> <input file>". Each is answered with the day's
+// output, followed by a line of "ok <seconds>" or "error <reason>". Requests
+// are answered one at a time, in order. On POSIX each is solved in a forked
+// child, so an input that trips a day's asserts fails only its own request,
+// and one that hangs is killed once it runs past the timeout.
+// The child works on a copy of the warmed tables, so anything a request adds
+// to them is gone by the next.
+
+namespace Service
+{
+	// How long solveContained waits on a solver before killing it, in
+	// seconds. 0 waits for as long as it takes. Defaults to 60.
+	void setTimeout(double seconds);
+
+	// Solves the day's input where a failure can't take the caller down with
+	// it: in a child process, on POSIX, so a solver that asserts on an input
+	// it can't handle only ends the child, and one that doesn't finish in
+	// time is killed. The child starts from a copy of this process, warmed
+	// tables and all, and its loops use threadCount threads (0 for as many
+	// as this process's). Returns an empty string on success, with the day's
+	// output and stats in output, or why it failed.
+	std::string solveContained(const Days::Day& day, const std::string& filename, std::string& output, unsigned threadCount = 0);
+
+	// Answers the requests read from in until it ends or sends "quit".
+	void serve(std::istream& in, std::ostream& out);
+
+	// Listens on a Unix domain socket at path and answers each connection's
+	// requests in turn, until the client closes it or sends "quit". False if
+	// the socket could not be set up (or on Windows, which this doesn't
+	// support).
+	bool serveSocket(const char* path);
+}
@@ -0,0 +1,105 @@
+#include "Stats.h"
+
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "Days.h"
+
+namespace Stats
+{
+	static std::mutex statsMutex;
+	static std::deque<Stat> stats; // deque so that references stay valid as it grows
+
+	Stat& registerStat(const char* name, bool isTimer)
+	{
+		std::lock_guard lock(statsMutex);
+
+		Stat& stat = stats.emplace_back();
+		stat.name = name;
+		stat.day = Days::currentDay();
+		stat.isTimer = isTimer;
+		return stat;
+	}
+
+	Stat& registerStat(const std::string& name, bool isTimer)
+	{
+		static std::deque<std::string> names;
+		const int day = Days::currentDay();
+
+		std::lock_guard lock(statsMutex);
+
+		for (Stat& stat : stats)
+			if (stat.day == day && stat.isTimer == isTimer && stat.name == name)
+				return stat;
+
+		Stat& stat = stats.emplace_back();
+		stat.name = names.emplace_back(name).c_str();
+		stat.day = day;
+		stat.isTimer = isTimer;
+		return stat;
+	}
+
+	void reset(int day)
+	{
+		std::lock_guard lock(statsMutex);
+
+		for (Stat& stat : stats)
+		{
+			if (stat.day != day)
+				continue;
+
+			stat.count = 0;
+			stat.nanoseconds = 0;
+		}
+	}
+
+	void printSummary(std::ostream& out, int day, double dayWallSeconds)
+	{
+		std::lock_guard lock(statsMutex);
+
+		size_t nameWidth = 0;
+		for (const Stat& stat : stats)
+			if (stat.day == day)
+				nameWidth = std::max(nameWidth, std::string(stat.name).size());
+
+		if (nameWidth == 0)
+			return;
+
+		const std::ios::fmtflags flags = out.flags();
+		const std::streamsize precision = out.precision();
+		out << "Stats:\n";
+
+		for (Stat& stat : stats)
+		{
+			if (stat.day != day)
+				continue;
+
+			const uint64_t count = stat.count.exchange(0);
+			const uint64_t nanoseconds = stat.nanoseconds.exchange(0);
+
+			out << "  " << std::left << std::setw(nameWidth) << stat.name << std::right;
+
+			if (stat.isTimer)
+			{
+				const double seconds = nanoseconds * 1e-9;
+				const double share = dayWallSeconds > 0.0 ? 100.0 * seconds / dayWallSeconds : 0.0;
+
+				out << std::fixed << std::setprecision(3)
+					<< "  " << std::setw(12) << seconds * 1e3 << "ms"
+					<< " (" << std::setprecision(1) << std::setw(5) << share << "%)"
+					<< "  calls " << count << '\n';
+			}
+			else
+			{
+				out << "  " << std::setw(12) << count << '\n';
+			}
+		}
+
+		out.flags(flags);
+		out.precision(precision);
+	}
+}
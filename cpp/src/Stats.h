@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Named counters and scoped timers for solver hot paths, e.g.
+//
+//     STATS_SCOPED_TIMER("d16::pathFind");
+//     STATS_COUNT("d16::pathFind nodes popped");
+//
+// They only exist in builds with AOC_STATS defined; otherwise the macros
+// expand to nothing. The runner prints a summary of each day's stats after
+// the day completes.
+
+namespace Stats
+{
+	struct Stat
+	{
+		const char* name = nullptr;
+		int day = 0;
+		bool isTimer = false;
+		std::atomic<uint64_t> count = 0;
+		std::atomic<uint64_t> nanoseconds = 0;
+	};
+
+	// Returns a stat that lives for the rest of the program, owned by the day
+	// currently running on this thread.
+	Stat& registerStat(const char* name, bool isTimer);
+
+	// For names built at run time. The name is copied, and registering the
+	// same name again for the same day gives back the same stat.
+	Stat& registerStat(const std::string& name, bool isTimer);
+
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(Stat& stat)
+			: stat(stat)
+			, start(std::chrono::steady_clock::now())
+		{
+		}
+
+		~ScopedTimer()
+		{
+			const auto elapsed = std::chrono::steady_clock::now() - start;
+			stat.count.fetch_add(1, std::memory_order_relaxed);
+			stat.nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), std::memory_order_relaxed);
+		}
+
+	private:
+		Stat& stat;
+		std::chrono::steady_clock::time_point start;
+	};
+
+	// Prints the day's stats (timers as a share of dayWallSeconds) and resets them.
+	void printSummary(std::ostream& out, int day, double dayWallSeconds);
+
+	// Resets the day's stats without printing them, e.g. after untimed work.
+	void reset(int day);
+}
+
+#define STATS_CONCAT_IMPL(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT_IMPL(a, b)
+
+#ifdef AOC_STATS
+
+#define STATS_ADD(name, n) \
+	do { \
+		static Stats::Stat& stat = Stats::registerStat(name, false); \
+		stat.count.fetch_add((uint64_t) (n), std::memory_order_relaxed); \
+	} while (false)
+
+#define STATS_COUNT(name) STATS_ADD(name, 1)
+
+#define STATS_SCOPED_TIMER(name) \
+	static Stats::Stat& STATS_CONCAT(stat, __LINE__) = Stats::registerStat(name, true); \
+	const Stats::ScopedTimer STATS_CONCAT(scopedTimer, __LINE__)(STATS_CONCAT(stat, __LINE__))
+
+#else
+
+#define STATS_ADD(name, n) ((void) 0)
+#define STATS_COUNT(name) ((void) 0)
+#define STATS_SCOPED_TIMER(name) ((void) 0)
+
+#endif
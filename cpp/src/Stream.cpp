@@ -0,0 +1,101 @@
+#include "Stream.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace Stream
+{
+	static std::atomic<bool> enabled = false;
+	static std::atomic<size_t> chunkSize = defaultChunkSize;
+
+	void setEnabled(bool value)
+	{
+		enabled = value;
+	}
+
+	bool isEnabled()
+	{
+		return enabled;
+	}
+
+	void setChunkSize(size_t value)
+	{
+		assert(value > 0);
+		chunkSize = value;
+	}
+
+	size_t getChunkSize()
+	{
+		return chunkSize;
+	}
+
+	LineReader::LineReader(const char* filename, size_t chunkSize)
+		: file(std::fopen(filename, "rb"))
+		, chunkSize(chunkSize)
+	{
+		if (file)
+			startRead();
+	}
+
+	LineReader::~LineReader()
+	{
+		if (reading.valid())
+			reading.wait();
+
+		if (file)
+			std::fclose(file);
+	}
+
+	void LineReader::startRead()
+	{
+		pending.resize(chunkSize);
+		reading = std::async(std::launch::async, [this] { return std::fread(pending.data(), 1, pending.size(), file); });
+	}
+
+	// Adds the chunk read in the background to the buffer and starts reading
+	// the one after. Returns false once the file is exhausted.
+	bool LineReader::fill()
+	{
+		if (!reading.valid())
+			return false;
+
+		const size_t size = reading.get();
+
+		buffer.erase(0, pos);
+		pos = 0;
+		buffer.append(pending.data(), size);
+
+		// A short read means the end of the file (or an error, which ends it too).
+		if (size == chunkSize)
+			startRead();
+
+		return size > 0;
+	}
+
+	std::optional<std::string_view> LineReader::next()
+	{
+		const char* newline = nullptr;
+
+		while (true)
+		{
+			newline = static_cast<const char*>(std::memchr(buffer.data() + pos, '\n', buffer.size() - pos));
+			if (newline || !fill())
+				break;
+		}
+
+		// Without a newline this is the end of the file, and what is left is
+		// the last line.
+		const char* start = buffer.data() + pos;
+		const char* end = newline ? newline : buffer.data() + buffer.size();
+		if (start == end && !newline)
+			return std::nullopt;
+
+		std::string_view line(start, end - start);
+		pos = (end - buffer.data()) + (newline ? 1 : 0);
+
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+
+		return line;
+	}
+}
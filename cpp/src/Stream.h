@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <future>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Reading an input a chunk at a time rather than all at once, for days whose
+// answers reduce over independent lines (see Harness::streamPrintAndAssert).
+// Memory use is bounded by two chunks plus the longest line, however big the
+// input, and the next chunk is read while the current one is being parsed.
+
+namespace Stream
+{
+	constexpr size_t defaultChunkSize = 1 << 20;
+
+	// Whether days that can stream their input should (--stream).
+	void setEnabled(bool enabled);
+	bool isEnabled();
+
+	void setChunkSize(size_t chunkSize);
+	size_t getChunkSize();
+
+	class LineReader
+	{
+	public:
+		explicit LineReader(const char* filename, size_t chunkSize = getChunkSize());
+		~LineReader();
+
+		LineReader(const LineReader&) = delete;
+		LineReader& operator=(const LineReader&) = delete;
+
+		bool isOpen() const { return file != nullptr; }
+
+		// The next line without its line ending, or nothing at the end of the
+		// file. The view is only valid until the following call.
+		std::optional<std::string_view> next();
+
+	private:
+		void startRead();
+		bool fill();
+
+		std::FILE* file = nullptr;
+		const size_t chunkSize;
+		std::string buffer; // the rest of the last chunk's final line, then the current chunk
+		size_t pos = 0;
+		std::string pending; // the chunk being read in the background
+		std::future<size_t> reading;
+	};
+
+	template <typename Fn>
+	void forEachLine(const char* filename, Fn&& fn)
+	{
+		LineReader reader(filename);
+		assert(reader.isOpen());
+
+		while (std::optional<std::string_view> line = reader.next())
+			fn(*line);
+	}
+}
@@ -1,29 +1,87 @@
 #include "String.h"
 
 #include <ranges>
-#include <fstream>
 #include <cassert>
+#include <cstring>
 
 namespace String
 {
-	std::vector<std::string> readLines(const char* filename)
+	Lines::Iterator::Iterator(const char* cursor, const char* end)
+		: cursor(cursor)
+		, end(end)
+	{
+		advance();
+	}
+
+	void Lines::Iterator::advance()
+	{
+		done = cursor == end;
+		if (done)
+			return;
+
+		const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+		const char* lineEnd = newline ? newline : end;
+
+		line = std::string_view(cursor, lineEnd - cursor);
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+
+		cursor = newline ? newline + 1 : end;
+	}
+
+	Lines::Lines(const char* filename)
+		: file(filename)
+	{
+		assert(file.isOpen());
+	}
+
+	Tokens::Tokens(std::string_view line, std::string_view delimiters)
+		: line(line)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		for (char c : delimiters)
+			isDelimiter.set((unsigned char) c);
+	}
 
+	Tokens::Iterator::Iterator(const Tokens& tokens)
+		: tokens(&tokens)
+	{
+		advance();
+	}
+
+	void Tokens::Iterator::advance()
+	{
+		const std::string_view line = tokens->line;
+
+		while (pos < line.size() && tokens->isDelimiter[(unsigned char) line[pos]])
+			++pos;
+
+		const size_t start = pos;
+		while (pos < line.size() && !tokens->isDelimiter[(unsigned char) line[pos]])
+			++pos;
+
+		// Tokens are never empty, so an empty one marks the end.
+		token = line.substr(start, pos - start);
+	}
+
+	void tokenize(std::string_view line, std::string_view delimiters, std::vector<std::string_view>& tokens)
+	{
+		tokens.clear();
+
+		for (std::string_view token : Tokens(line, delimiters))
+			tokens.push_back(token);
+	}
+
+	std::vector<std::string> readLines(const char* filename)
+	{
 		std::vector<std::string> lines;
 
-		while (s.peek() != EOF)
-		{
-			std::string line;
-			std::getline(s, line);
-			lines.push_back(line);
-		}
+		for (std::string_view line : Lines(filename))
+			lines.emplace_back(line);
 
 		return lines;
 	}
 
-	std::vector<std::string> delimit(const std::string& line, char delimiter)
+	std::vector<std::string> delimit(std::string_view line, char delimiter)
 	{
 		std::vector<std::string> delimited;
 
@@ -34,23 +92,12 @@ namespace String
 		return delimited;
 	}
 
-	std::vector<std::string> delimit(const std::string& line, const std::string& delimiters)
+	std::vector<std::string> delimit(std::string_view line, std::string_view delimiters)
 	{
 		std::vector<std::string> delimited;
-		delimited.push_back(line);
 
-		std::vector<std::string> scratch;
-		for (char c : delimiters)
-		{
-			for (const std::string& word : delimited)
-			{
-				for (std::string& w : delimit(word, c))
-					if (!w.empty())
-						scratch.push_back(std::move(w));
-			}
-
-			delimited = std::exchange(scratch, {});
-		}
+		for (std::string_view token : Tokens(line, delimiters))
+			delimited.emplace_back(token);
 
 		return delimited;
 	}
@@ -1,14 +1,149 @@
 #pragma once
 
+#include <bitset>
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <string>
 
+#include "MappedFile.h"
+
 namespace String
 {
+	// The lines of a file without copying them: the file is memory-mapped and
+	// each line is a view into the mapping, valid for as long as the Lines
+	// object. Lines end at "\n" or "\r\n", and a final line ending does not
+	// start another (empty) line, the same as readLines.
+	class Lines
+	{
+	public:
+		class Iterator
+		{
+		public:
+			using value_type = std::string_view;
+			using difference_type = std::ptrdiff_t;
+
+			Iterator() = default;
+			Iterator(const char* cursor, const char* end);
+
+			std::string_view operator*() const { return line; }
+
+			Iterator& operator++() { advance(); return *this; }
+			void operator++(int) { advance(); }
+
+			bool operator==(std::default_sentinel_t) const { return done; }
+
+		private:
+			void advance();
+
+			const char* cursor = nullptr;
+			const char* end = nullptr;
+			std::string_view line;
+			bool done = true;
+		};
+
+		explicit Lines(const char* filename);
+
+		Iterator begin() const { return {file.data(), file.data() + file.size()}; }
+		std::default_sentinel_t end() const { return {}; }
+
+	private:
+		MappedFile file;
+	};
+
+	// The non-empty runs of characters between any of the delimiters, as views
+	// into line, found in a single pass without allocating.
+	class Tokens
+	{
+	public:
+		class Iterator
+		{
+		public:
+			using value_type = std::string_view;
+			using difference_type = std::ptrdiff_t;
+
+			Iterator() = default;
+			explicit Iterator(const Tokens& tokens);
+
+			std::string_view operator*() const { return token; }
+
+			Iterator& operator++() { advance(); return *this; }
+			void operator++(int) { advance(); }
+
+			bool operator==(std::default_sentinel_t) const { return token.empty(); }
+
+		private:
+			void advance();
+
+			const Tokens* tokens = nullptr;
+			size_t pos = 0;
+			std::string_view token;
+		};
+
+		Tokens(std::string_view line, std::string_view delimiters);
+
+		Iterator begin() const { return Iterator(*this); }
+		std::default_sentinel_t end() const { return {}; }
+
+	private:
+		std::string_view line;
+		std::bitset<256> isDelimiter;
+	};
+
+	// Replaces the contents of tokens with those of Tokens(line, delimiters), so
+	// that a buffer reused from line to line stops allocating.
+	void tokenize(std::string_view line, std::string_view delimiters, std::vector<std::string_view>& tokens);
+
 	std::vector<std::string> readLines(const char* filename);
 
-	std::vector<std::string> delimit(const std::string& line, char delimiter);
-	std::vector<std::string> delimit(const std::string& line, const std::string& delimiters);
+	std::vector<std::string> delimit(std::string_view line, char delimiter);
+	// Splits on every delimiter, dropping empty words (see Tokens).
+	std::vector<std::string> delimit(std::string_view line, std::string_view delimiters);
 
 	std::string trim(const std::string& str);
+
+	// Appends every integer in text to numbers in a single pass, skipping
+	// whatever lies between them. For signed types a '-' directly before the
+	// digits makes the number negative. False if any number didn't fit in T;
+	// those are skipped rather than appended as 0.
+	template <typename T>
+	bool parseInts(std::string_view text, std::vector<T>& numbers)
+	{
+		static_assert(std::is_integral_v<T>);
+
+		auto isDigit = [] (char c) { return c >= '0' && c <= '9'; };
+
+		const char* cursor = text.data();
+		const char* const end = cursor + text.size();
+		bool allFit = true;
+
+		while (cursor != end)
+		{
+			const bool isNegative = std::is_signed_v<T> && *cursor == '-' && cursor + 1 != end && isDigit(cursor[1]);
+			if (!isNegative && !isDigit(*cursor))
+			{
+				++cursor;
+				continue;
+			}
+
+			T value = 0;
+			const std::from_chars_result result = std::from_chars(cursor, end, value);
+			cursor = result.ptr;
+
+			if (result.ec == std::errc::result_out_of_range)
+			{
+				allFit = false;
+				continue;
+			}
+
+			assert(result.ec == std::errc());
+			numbers.push_back(value);
+		}
+
+		return allFit;
+	}
 }
\ No newline at end of file
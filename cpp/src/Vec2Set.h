@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "Vec2.h"
+
+// Flat hash tables keyed by Vec2, for sets of positions that have no handy
+// bounds to size a Grid by. Open addressing with linear probing in one
+// power-of-two array of slots, so an insert is a hash and usually a single
+// probe, with no allocation once the table has grown (or been reserved) big
+// enough. clear() doesn't touch the slots: each slot remembers which
+// generation of the table it was filled in, and clearing starts a new one.
+// Entries can't be erased on their own. Iteration order is unspecified.
+
+namespace Vec2Hash
+{
+	// Fibonacci hashing of both coordinates packed into one word. The top
+	// bits are the well mixed ones, so tables index by those.
+	inline uint64_t hash(Vec2 pos)
+	{
+		const uint64_t packed = ((uint64_t) (uint32_t) pos.x << 32) | (uint32_t) pos.y;
+		return packed * 0x9e3779b97f4a7c15ull;
+	}
+}
+
+template <typename Value>
+class Vec2Map
+{
+public:
+	struct Entry
+	{
+		Vec2 key;
+		Value value;
+	};
+
+private:
+	struct Slot
+	{
+		Entry entry;
+		uint32_t generation = 0;
+	};
+
+public:
+	class Iterator
+	{
+	public:
+		using value_type = Entry;
+		using difference_type = std::ptrdiff_t;
+
+		Iterator() = default;
+		Iterator(const Vec2Map* map, size_t index) : map(map), index(index) { skipEmpty(); }
+
+		const Entry& operator*() const { return map->slots[index].entry; }
+		const Entry* operator->() const { return &map->slots[index].entry; }
+
+		Iterator& operator++() { ++index; skipEmpty(); return *this; }
+		Iterator operator++(int) { Iterator copy = *this; ++*this; return copy; }
+
+		bool operator==(const Iterator& r) const { return index == r.index; }
+
+	private:
+		void skipEmpty()
+		{
+			while (index < map->slots.size() && !map->isFull(map->slots[index]))
+				++index;
+		}
+
+		const Vec2Map* map = nullptr;
+		size_t index = 0;
+	};
+
+	Vec2Map() = default;
+	explicit Vec2Map(size_t expectedSize) { reserve(expectedSize); }
+
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	// Grows the table now so that expectedSize entries fit without a rehash.
+	void reserve(size_t expectedSize)
+	{
+		const size_t capacity = std::bit_ceil(std::max<size_t>(minCapacity, expectedSize + expectedSize / 3 + 1));
+		if (capacity > slots.size())
+			rehash(capacity);
+	}
+
+	void clear()
+	{
+		count = 0;
+
+		if (++generation == 0)
+		{
+			for (Slot& slot : slots)
+				slot.generation = 0;
+
+			generation = 1;
+		}
+	}
+
+	bool contains(Vec2 key) const { return find(key) != nullptr; }
+
+	const Value* find(Vec2 key) const
+	{
+		if (slots.empty())
+			return nullptr;
+
+		const Slot& slot = slots[findSlot(key)];
+		return isFull(slot) ? &slot.entry.value : nullptr;
+	}
+
+	Value* find(Vec2 key)
+	{
+		return const_cast<Value*>(static_cast<const Vec2Map*>(this)->find(key));
+	}
+
+	// Adds the entry unless the key is already there, like try_emplace. True
+	// if it was added; either way the value is the one now in the table.
+	std::pair<Value*, bool> insert(Vec2 key, const Value& value = Value())
+	{
+		if ((count + 1) * 4 > slots.size() * 3)
+			rehash(std::max(minCapacity, slots.size() * 2));
+
+		Slot& slot = slots[findSlot(key)];
+		if (isFull(slot))
+			return {&slot.entry.value, false};
+
+		slot.entry = {key, value};
+		slot.generation = generation;
+		++count;
+		return {&slot.entry.value, true};
+	}
+
+	Value& operator[](Vec2 key)
+	{
+		return *insert(key).first;
+	}
+
+	Iterator begin() const { return Iterator(this, 0); }
+	Iterator end() const { return Iterator(this, slots.size()); }
+
+private:
+	static constexpr size_t minCapacity = 16;
+
+	bool isFull(const Slot& slot) const { return slot.generation == generation; }
+
+	// The slot holding key, or the empty one where it belongs.
+	size_t findSlot(Vec2 key) const
+	{
+		assert(std::has_single_bit(slots.size()));
+
+		const size_t mask = slots.size() - 1;
+		for (size_t index = Vec2Hash::hash(key) >> shift; ; index = (index + 1) & mask)
+		{
+			const Slot& slot = slots[index];
+			if (!isFull(slot) || slot.entry.key == key)
+				return index;
+		}
+	}
+
+	void rehash(size_t capacity)
+	{
+		std::vector<Slot> old = std::exchange(slots, std::vector<Slot>(capacity));
+		shift = 64 - std::countr_zero(capacity);
+
+		const uint32_t oldGeneration = std::exchange(generation, 1);
+		for (const Slot& slot : old)
+		{
+			if (slot.generation != oldGeneration)
+				continue;
+
+			Slot& moved = slots[findSlot(slot.entry.key)];
+			moved.entry = std::move(slot.entry);
+			moved.generation = generation;
+		}
+	}
+
+	std::vector<Slot> slots;
+	size_t count = 0;
+	uint32_t generation = 1;
+	int shift = 64;
+};
+
+class Vec2Set
+{
+	struct Empty {};
+
+public:
+	class Iterator
+	{
+	public:
+		using value_type = Vec2;
+		using difference_type = std::ptrdiff_t;
+
+		Iterator() = default;
+		explicit Iterator(Vec2Map<Empty>::Iterator it) : it(it) {}
+
+		Vec2 operator*() const { return it->key; }
+
+		Iterator& operator++() { ++it; return *this; }
+		Iterator operator++(int) { Iterator copy = *this; ++it; return copy; }
+
+		bool operator==(const Iterator& r) const { return it == r.it; }
+
+	private:
+		Vec2Map<Empty>::Iterator it;
+	};
+
+	Vec2Set() = default;
+	explicit Vec2Set(size_t expectedSize) : map(expectedSize) {}
+
+	size_t size() const { return map.size(); }
+	bool empty() const { return map.empty(); }
+	void reserve(size_t expectedSize) { map.reserve(expectedSize); }
+	void clear() { map.clear(); }
+
+	bool contains(Vec2 pos) const { return map.contains(pos); }
+
+	// True if pos wasn't already in the set.
+	bool insert(Vec2 pos) { return map.insert(pos).second; }
+
+	Iterator begin() const { return Iterator(map.begin()); }
+	Iterator end() const { return Iterator(map.end()); }
+
+private:
+	Vec2Map<Empty> map;
+};
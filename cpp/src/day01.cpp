@@ -9,31 +9,38 @@
 #include <unordered_map>
 #include <cstdint>
 
+#include "Harness.h"
+#include "MappedFile.h"
+#include "String.h"
+
 struct Data01
 {
 	std::vector<int64_t> leftList;
 	std::vector<int64_t> rightList;
 };
 
+static void serialize(Cache::Archive& archive, Data01& data)
+{
+	archive(data.leftList, data.rightList);
+}
+
 static Data01 readData(const char* filename)
 {
-	std::fstream s{filename, s.in};
-	assert(s.is_open());
+	const MappedFile file(filename);
+	assert(file.isOpen());
+
+	std::vector<int64_t> numbers;
+	String::parseInts({file.data(), file.size()}, numbers);
+	assert(numbers.size() % 2 == 0);
 
 	Data01 data;
+	data.leftList.reserve(numbers.size() / 2);
+	data.rightList.reserve(numbers.size() / 2);
 
-	while (s.peek() != EOF)
+	for (size_t i = 0; i < numbers.size(); i += 2)
 	{
-		std::string line;
-		std::getline(s, line);
-		assert(line.size() > 0);
-
-		const int64_t left = std::stoi(line);
-		const size_t pos = line.find(' ');
-		const int64_t right = std::stoi(line.substr(pos));
-
-		data.leftList.push_back(left);
-		data.rightList.push_back(right);
+		data.leftList.push_back(numbers[i]);
+		data.rightList.push_back(numbers[i + 1]);
 	}
 
 	std::sort(begin(data.leftList), end(data.leftList));
@@ -68,26 +75,9 @@ static int64_t part2(const Data01& data)
 	return simScore;
 }
 
-static void process(const char* filename, std::optional<int64_t> expected1 = {}, std::optional<int64_t> expected2 = {})
+static void process(const char* filename, int64_t expected1, int64_t expected2)
 {
-	const Data01 data = readData(filename);
-	const int64_t result1 = part1(data);
-	const int64_t result2 = part2(data);
-
-	std::cout << "--- " << filename << " ---" << std::endl;
-	
-	std::cout << "pt1: " << result1;
-	if (expected1)
-		std::cout << " (expected: " << expected1.value() << ")";
-	std::cout << std::endl;
-
-	std::cout << "pt2: " << result2;
-	if (expected2)
-		std::cout << " (expected: " << expected2.value() << ")";
-	std::cout << std::endl;
-
-	assert(!expected1 || result1 == expected1.value());
-	assert(!expected2 || result2 == expected2.value());
+	Harness::processPrintAndAssert(filename, readData, part1, part2, expected1, expected2);
 }
 
 void day01()
@@ -95,3 +85,5 @@ void day01()
 	process("../data/01/test.txt", 11, 31);
 	process("../data/01/real.txt", 2057374, 23177084);
 }
+
+static Days::Registrar registrar(1, day01, [] (const char* filename) { process(filename, 0, 0); });
@@ -12,6 +12,9 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Harness.h"
+#include "String.h"
+
 namespace d02
 {
 	struct Data02
@@ -19,28 +22,21 @@ namespace d02
 		std::vector<std::vector<int64_t>> reports;
 	};
 
-	static auto loadData(const char* filename)
+	static void serialize(Cache::Archive& archive, Data02& data)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		archive(data.reports);
+	}
 
+	static auto loadData(const char* filename)
+	{
 		Data02 data;
 
-		while (s.peek() != EOF)
+		for (std::string_view line : String::Lines(filename))
 		{
-			std::string line;
-			std::getline(s, line);
 			assert(line.size() > 0);
 
 			data.reports.push_back({});
-
-			for (const auto word : std::views::split(line, ' '))
-			{
-				const std::string token(&*word.begin(), std::ranges::distance(word));
-
-				const int64_t num = std::stoull(token);
-				data.reports.back().push_back(num);
-			}
+			String::parseInts(line, data.reports.back());
 		}
 
 		return data;
@@ -73,7 +69,7 @@ namespace d02
 		return true;
 	}
 
-	static int64_t partOne(const auto& data)
+	static int64_t partOne(const Data02& data)
 	{
 		return std::accumulate(
 			begin(data.reports),
@@ -86,7 +82,23 @@ namespace d02
 		);
 	}
 
-	static int64_t partTwo(const auto& data)
+	static bool isSafeWithDampener(const std::vector<int64_t>& report)
+	{
+		if (isSafe(report))
+			return true;
+
+		for (size_t i = 0; i < report.size(); ++i)
+		{
+			auto copy = report;
+			copy.erase(copy.begin() + i);
+			if (isSafe(copy))
+				return true;
+		}
+
+		return false;
+	}
+
+	static int64_t partTwo(const Data02& data)
 	{
 		return std::accumulate(
 			begin(data.reports),
@@ -94,35 +106,36 @@ namespace d02
 			0ll,
 			[] (int64_t sum, const std::vector<int64_t>& report)
 			{
-				if (isSafe(report))
-					return sum + 1;
-
-				for (size_t i = 0; i < report.size(); ++i)
-				{
-					auto copy = report;
-					copy.erase(copy.begin() + i);
-					if (isSafe(copy))
-						return sum + 1;
-				}
-
-				return sum;
+				return sum + (isSafeWithDampener(report) ? 1 : 0);
 			}
 		);
 	}
 
-	static std::pair<int64_t, int64_t> process(const char* filename)
+	struct Reducer
 	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
-	}
+		std::vector<int64_t> report;
+		int64_t numSafe = 0;
+		int64_t numSafeWithDampener = 0;
+
+		void add(std::string_view line)
+		{
+			report.clear();
+			String::parseInts(line, report);
+
+			numSafe += isSafe(report) ? 1 : 0;
+			numSafeWithDampener += isSafeWithDampener(report) ? 1 : 0;
+		}
+
+		int64_t partOne() const { return numSafe; }
+		int64_t partTwo() const { return numSafeWithDampener; }
+	};
 
 	static void processPrintAndAssert(const char* filename, std::pair<int64_t, int64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		if (Stream::isEnabled())
+			Harness::streamPrintAndAssert<Reducer>(filename, expected.first, expected.second);
+		else
+			Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -131,3 +144,5 @@ void day02()
 	d02::processPrintAndAssert("../data/02/test.txt", std::make_pair(2ll, 4ll));
 	d02::processPrintAndAssert("../data/02/real.txt", std::make_pair(598ll, 0ll));
 }
+
+static Days::Registrar registrar(2, day02, [] (const char* filename) { d02::processPrintAndAssert(filename, {}); });
@@ -12,6 +12,8 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Harness.h"
+
 namespace d03
 {
 	static auto loadData(const char* filename)
@@ -139,19 +141,9 @@ namespace d03
 		return sum;
 	}
 
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
-	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
-	}
-
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -161,3 +153,5 @@ void day03()
 	d03::processPrintAndAssert("../data/03/test2.txt", std::make_pair(161ull, 48ull));
 	d03::processPrintAndAssert("../data/03/real.txt", std::make_pair(160672468ull, 84893551ull));
 }
+
+static Days::Registrar registrar(3, day03, [] (const char* filename) { d03::processPrintAndAssert(filename, {}); });
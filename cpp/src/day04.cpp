@@ -12,6 +12,8 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Harness.h"
+
 namespace d04
 {
 	struct Data04
@@ -21,6 +23,11 @@ namespace d04
 		int cols = 0;
 	};
 
+	static void serialize(Cache::Archive& archive, Data04& data)
+	{
+		archive(data.grid, data.rows, data.cols);
+	}
+
 	static Data04 loadData(const char* filename)
 	{
 		std::fstream s{ filename, s.in };
@@ -201,19 +208,9 @@ namespace d04
 		return count;
 	}
 
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
-	{
-		const Data04 data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
-	}
-
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -222,3 +219,5 @@ void day04()
 	d04::processPrintAndAssert("../data/04/test.txt", std::make_pair(18ull, 9ull));
 	d04::processPrintAndAssert("../data/04/real.txt", std::make_pair(2593ull, 1950ull));
 }
+
+static Days::Registrar registrar(4, day04, [] (const char* filename) { d04::processPrintAndAssert(filename, {}); });
@@ -12,6 +12,9 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Harness.h"
+#include "String.h"
+
 namespace d05
 {
 	struct Data05
@@ -58,6 +61,11 @@ namespace d05
 
 	};
 
+	static void serialize(Cache::Archive& archive, Data05& data)
+	{
+		archive(data.pageOrdering, data.pageUpdates, data.pageDeps);
+	}
+
 	static uint64_t getMiddlePage(const std::vector<uint64_t>& pages)
 	{
 		assert(pages.size() % 2 == 1);
@@ -66,17 +74,14 @@ namespace d05
 
 	static auto loadData(const char* filename)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
-
 		Data05 data;
 
 		bool parseUpdates = false;
+		std::vector<uint64_t> pages;
 
-		while (s.peek() != EOF)
+		for (std::string_view line : String::Lines(filename))
 		{
-			std::string line;
-			std::getline(s, line);
+			pages.clear();
 
 			if (line.size() == 0)
 			{
@@ -84,25 +89,13 @@ namespace d05
 			}
 			else if (parseUpdates)
 			{
-				std::vector<uint64_t> pages;
-				for (const auto page : std::views::split(line, ','))
-				{
-					const std::string pageStr(&*page.begin(), std::ranges::distance(page));
-					pages.push_back(std::stoull(pageStr));
-				}
-
+				String::parseInts(line, pages);
 				assert(pages.size() % 2 == 1); // odd count
-				data.pageUpdates.push_back(std::move(pages));
+				data.pageUpdates.push_back(pages);
 			}
 			else
 			{
-				std::vector<uint64_t> pages;
-				for (const auto page : std::views::split(line, '|'))
-				{
-					const std::string pageStr(&*page.begin(), std::ranges::distance(page));
-					pages.push_back(std::stoull(pageStr));
-				}
-
+				String::parseInts(line, pages);
 				assert(pages.size() == 2);
 				data.pageOrdering.emplace_back(pages[0], pages[1]);
 			}
@@ -141,19 +134,9 @@ namespace d05
 		return middlePageSum;
 	}
 
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
-	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
-	}
-
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -162,3 +145,5 @@ void day05()
 	d05::processPrintAndAssert("../data/05/test.txt", std::make_pair(143ull, 123ull));
 	d05::processPrintAndAssert("../data/05/real.txt", std::make_pair(5391ull, 0ull));
 }
+
+static Days::Registrar registrar(5, day05, [] (const char* filename) { d05::processPrintAndAssert(filename, {}); });
@@ -11,105 +11,97 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include "Grid.h"
+#include "Harness.h"
+#include "Parallel.h"
+#include "Stats.h"
+#include "String.h"
 #include "Vec2.h"
+#include "Vec2Set.h"
 
 namespace d06
 {
-	struct Grid
+	enum class Cell : uint8_t
 	{
-		std::vector<std::vector<bool>> cells;
-
-		bool isInBounds(Vec2 pos) const
-		{
-			constexpr int minX = 0;
-			constexpr int minY = 0;
-			const int maxX = (int) cells.front().size();
-			const int maxY = (int) cells.size();
-
-			return minX <= pos.x
-				&& minY <= pos.y
-				&& pos.x < maxX
-				&& pos.y < maxY;
-		}
-
-		bool isObstacle(Vec2 pos) const
-		{
-			return cells[pos.y][pos.x];
-		}
+		Open,
+		Obstacle,
+		Outside, // the border around the map, where the guard leaves
 	};
 
 	struct Data06
 	{
-		Grid grid;
+		Grid<Cell> grid;
 		Vec2 start;
 	};
 
-	static auto loadData(const char* filename)
+	static void serialize(Cache::Archive& archive, Data06& data)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		archive(data.grid, data.start);
+	}
 
+	static auto loadData(const char* filename)
+	{
 		Data06 data;
 
-		while (s.peek() != EOF)
+		auto toCell = [&] (char c, Vec2 pos)
 		{
-			std::string line;
-			std::getline(s, line);
-			assert(line.size() > 0);
+			if (c == '^')
+				data.start = pos;
+			else
+				assert(c == '.' || c == '#');
 
-			data.grid.cells.push_back({});
-			std::vector<bool>& row = data.grid.cells.back();
+			return c == '#' ? Cell::Obstacle : Cell::Open;
+		};
 
-			for (char c : line)
-			{
-				if (c == '.')
-					row.push_back(false);
-				else if (c == '#')
-					row.push_back(true);
-				else if (c == '^')
-				{
-					row.push_back(false);
-					data.start = {(int) row.size() - 1, (int) data.grid.cells.size() - 1};
-				}
-				else
-					assert(false);
-			}
-
-			assert(data.grid.cells.front().size() == row.size());
-		}
+		constexpr int padding = 1;
+		data.grid = Grid<Cell>::fromLines(String::Lines(filename), toCell, padding, Cell::Outside);
 
 		return data;
 	}
 
-	std::optional<size_t> walkUntilLoopOrExit(const Grid& grid, const Vec2 start, std::set<Vec2>& visited)
+	// The directions the guard has left each position in, one bit each.
+	using LoopDetect = Vec2Map<uint8_t>;
+
+	static uint8_t getDirectionBit(Direction dir)
+	{
+		return (uint8_t) (1 << (int) dir);
+	}
+
+	std::optional<size_t> walkUntilLoopOrExit(const Grid<Cell>& grid, const Vec2 start, Vec2Set& visited, LoopDetect& loopDetect)
 	{
-		std::set<std::pair<Vec2, Direction>> loopDetect;
+		STATS_SCOPED_TIMER("d06::walkUntilLoopOrExit");
+		STATS_COUNT("d06::walkUntilLoopOrExit walks");
+
+		loopDetect.clear();
 
 		Direction dir = Direction::Up;
 		Vec2 delta = Vec2::directions[(int) dir];
 		Vec2 pos = start;
 
 		visited.insert(pos);
-		loopDetect.insert({pos, dir});
+		loopDetect[pos] |= getDirectionBit(dir);
 
 		while (true)
 		{
 			const Vec2 next = pos + delta;
-			if (!grid.isInBounds(next))
+			const Cell cell = grid[next];
+			if (cell == Cell::Outside)
 			{
 				pos = next;
 				break;
 			}
-			else if (loopDetect.contains({next, dir}))
+			else if (const uint8_t* dirs = loopDetect.find(next); dirs && (*dirs & getDirectionBit(dir)))
 			{
 				break;
 			}
 
-			if (!grid.isObstacle(next))
+			STATS_COUNT("d06::walkUntilLoopOrExit steps");
+
+			if (cell != Cell::Obstacle)
 			{
 				pos = next;
 				visited.insert(pos);
-				loopDetect.insert({pos, dir});
+				loopDetect[pos] |= getDirectionBit(dir);
 			}
 			else
 			{
@@ -126,46 +118,51 @@ namespace d06
 
 	static uint64_t partOne(const Data06& data)
 	{
-		std::set<Vec2> visited;
-		return walkUntilLoopOrExit(data.grid, data.start, visited).value();
+		Vec2Set visited;
+		LoopDetect loopDetect;
+		return walkUntilLoopOrExit(data.grid, data.start, visited, loopDetect).value();
 	}
 
 	static uint64_t partTwo(const Data06& data)
 	{
-		std::set<Vec2> possObsLocs;
-		walkUntilLoopOrExit(data.grid, data.start, possObsLocs);
+		STATS_SCOPED_TIMER("d06::partTwo");
 
-		uint64_t numPossibleNewObstacleLocs = 0;
+		Vec2Set possObsLocs;
+		LoopDetect loopDetect;
+		walkUntilLoopOrExit(data.grid, data.start, possObsLocs, loopDetect);
 
+		std::vector<Vec2> candidates;
 		for (const Vec2 loc : possObsLocs)
+			if (loc != data.start)
+				candidates.push_back(loc);
+
+		// Each chunk of candidates gets its own copy of the grid to place them in.
+		return Parallel::reduceChunks(0, candidates.size(), 0ull, [&] (size_t begin, size_t end)
 		{
-			if (loc == data.start)
-				continue;
+			Grid<Cell> grid = data.grid;
+			Vec2Set visited;
+			LoopDetect chunkLoopDetect;
+			uint64_t numPossibleNewObstacleLocs = 0;
 
-			Grid grid = data.grid;
-			grid.cells[loc.y][loc.x] = true;
+			for (size_t i = begin; i < end; ++i)
+			{
+				const Vec2 loc = candidates[i];
+				grid[loc] = Cell::Obstacle;
 
-			std::set<Vec2> visited;
-			if (!walkUntilLoopOrExit(grid, data.start, visited))
-				++numPossibleNewObstacleLocs;
-		}
+				visited.clear();
+				if (!walkUntilLoopOrExit(grid, data.start, visited, chunkLoopDetect))
+					++numPossibleNewObstacleLocs;
 
-		return numPossibleNewObstacleLocs;
-	}
+				grid[loc] = Cell::Open;
+			}
 
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
-	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
+			return numPossibleNewObstacleLocs;
+		}, std::plus<>());
 	}
 
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -174,3 +171,5 @@ void day06()
 	d06::processPrintAndAssert("../data/06/test.txt", std::make_pair(41ull, 6ull));
 	d06::processPrintAndAssert("../data/06/real.txt", std::make_pair(4665ull, 1688ull));
 }
+
+static Days::Registrar registrar(6, day06, [] (const char* filename) { d06::processPrintAndAssert(filename, {}); });
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <functional>
@@ -12,6 +13,10 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Harness.h"
+#include "Parallel.h"
+#include "String.h"
+
 namespace d07
 {
 	struct Equation
@@ -20,38 +25,47 @@ namespace d07
 		std::vector<uint64_t> operands;
 	};
 
+	static void serialize(Cache::Archive& archive, Equation& eq)
+	{
+		archive(eq.total, eq.operands);
+	}
+
 	struct Data07
 	{
 		std::vector<Equation> equations;
 	};
 
-	static auto loadData(const char* filename)
+	static void serialize(Cache::Archive& archive, Data07& data)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		archive(data.equations);
+	}
 
+	static void unittest_parseInts()
+	{
+		// 2^64 doesn't fit, so it is skipped rather than read as 0.
+		std::vector<uint64_t> numbers;
+		assert(!String::parseInts("18446744073709551616: 6 18446744073709551615", numbers));
+		assert((numbers == std::vector<uint64_t>{6, 18446744073709551615ull}));
+	}
+
+	static auto loadData(const char* filename)
+	{
 		Data07 data;
+		std::vector<uint64_t> numbers;
 
-		while (s.peek() != EOF)
+		for (std::string_view line : String::Lines(filename))
 		{
-			std::string line;
-			std::getline(s, line);
 			assert(line.size() > 0);
 
-			Equation eq;
+			numbers.clear();
+			[[maybe_unused]] const bool parsed = String::parseInts(line, numbers);
+			assert(parsed && numbers.size() > 1);
 
-			for (const auto word : std::views::split(line, ' '))
-			{
-				const std::string token(&*word.begin(), std::ranges::distance(word));
-
-				const uint64_t num = std::stoull(token);
-				if (eq.total == 0)
-					eq.total = num;
-				else
-					eq.operands.push_back(num);
-			}
+			Equation eq;
+			eq.total = numbers.front();
+			eq.operands.assign(numbers.begin() + 1, numbers.end());
 
-			data.equations.push_back(eq);
+			data.equations.push_back(std::move(eq));
 		}
 
 		return data;
@@ -90,48 +104,72 @@ namespace d07
 
 	static uint64_t partOne(const Data07& data)
 	{
-		return std::accumulate(
-			begin(data.equations),
-			end(data.equations),
+		return Parallel::reduce(
+			0,
+			data.equations.size(),
 			0ull,
-			[] (uint64_t sum, const Equation& eq)
+			[&] (size_t i)
 			{
-				return sum + (canEvaluate(eq, 2) ? eq.total : 0);
-			}
+				const Equation& eq = data.equations[i];
+				return canEvaluate(eq, 2) ? eq.total : 0;
+			},
+			std::plus<>()
 		);
 	}
 
-	static uint64_t partTwo(const auto& data)
+	static uint64_t partTwo(const Data07& data)
 	{
-		return std::accumulate(
-			begin(data.equations),
-			end(data.equations),
+		return Parallel::reduce(
+			0,
+			data.equations.size(),
 			0ull,
-			[] (uint64_t sum, const Equation& eq)
+			[&] (size_t i)
 			{
-				return sum + (canEvaluate(eq, 3) ? eq.total : 0);
-			}
+				const Equation& eq = data.equations[i];
+				return canEvaluate(eq, 3) ? eq.total : 0;
+			},
+			std::plus<>()
 		);
 	}
 
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
+	struct Reducer
 	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
-	}
+		std::vector<uint64_t> numbers;
+		Equation eq;
+		uint64_t sumTwoOps = 0;
+		uint64_t sumThreeOps = 0;
+
+		void add(std::string_view line)
+		{
+			numbers.clear();
+			[[maybe_unused]] const bool parsed = String::parseInts(line, numbers);
+			assert(parsed && numbers.size() > 1);
+
+			eq.total = numbers.front();
+			eq.operands.assign(numbers.begin() + 1, numbers.end());
+
+			sumTwoOps += canEvaluate(eq, 2) ? eq.total : 0;
+			sumThreeOps += canEvaluate(eq, 3) ? eq.total : 0;
+		}
+
+		uint64_t partOne() const { return sumTwoOps; }
+		uint64_t partTwo() const { return sumThreeOps; }
+	};
 
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		if (Stream::isEnabled())
+			Harness::streamPrintAndAssert<Reducer>(filename, expected.first, expected.second);
+		else
+			Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
 void day07()
 {
+	d07::unittest_parseInts();
 	d07::processPrintAndAssert("../data/07/test.txt", std::make_pair(3749ull, 11387ull));
 	d07::processPrintAndAssert("../data/07/real.txt", std::make_pair(3245122495150ull, 105517128211543ull));
 }
+
+static Days::Registrar registrar(7, day07, [] (const char* filename) { d07::processPrintAndAssert(filename, {}); });
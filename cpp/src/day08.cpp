@@ -12,7 +12,10 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Days.h"
+#include "Harness.h"
 #include "Vec2.h"
+#include "Vec2Set.h"
 
 namespace d08
 {
@@ -22,6 +25,11 @@ namespace d08
 		Bounds bounds;
 	};
 
+	static void serialize(Cache::Archive& archive, Data08& data)
+	{
+		archive(data.antennaPositions, data.bounds);
+	}
+
 	static auto loadData(const char* filename)
 	{
 		std::fstream s{ filename, s.in };
@@ -75,7 +83,7 @@ namespace d08
 		}
 	}
 
-	static void printNodes(const std::set<Vec2>& nodes, const Vec2& size)
+	static void printNodes(const Vec2Set& nodes, const Vec2& size)
 	{
 		std::vector<bool> rowProto(size.x, false);
 		std::vector<std::vector<bool>> grid(size.y, rowProto);
@@ -87,16 +95,16 @@ namespace d08
 		{
 			for (size_t x = 0; x < grid.front().size(); ++x)
 			{
-				std::cout << (grid[y][x] ? 'X' : '.');
+				Days::out() << (grid[y][x] ? 'X' : '.');
 			}
 
-			std::cout << std::endl;
+			Days::out() << std::endl;
 		}
 	}
 
 	static uint64_t partOne(const Data08& data)
 	{
-		std::set<Vec2> antiNodes;
+		Vec2Set antiNodes;
 
 		forEachNodePair(data, [&] (Vec2 pos1, Vec2 pos2)
 		{
@@ -116,7 +124,7 @@ namespace d08
 
 	static uint64_t partTwo(const Data08& data)
 	{
-		std::set<Vec2> antiNodes;
+		Vec2Set antiNodes;
 
 		forEachNodePair(data, [&] (Vec2 pos1, Vec2 pos2)
 		{
@@ -148,19 +156,9 @@ namespace d08
 		return antiNodes.size();
 	}
 
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
-	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
-	}
-
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -169,3 +167,5 @@ void day08()
 	d08::processPrintAndAssert("../data/08/test.txt", std::make_pair(14ull, 34ull));
 	d08::processPrintAndAssert("../data/08/real.txt", std::make_pair(344ull, 1182ull));
 }
+
+static Days::Registrar registrar(8, day08, [] (const char* filename) { d08::processPrintAndAssert(filename, {}); });
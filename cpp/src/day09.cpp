@@ -12,6 +12,8 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Harness.h"
+
 namespace d09
 {
 	struct Block
@@ -37,6 +39,11 @@ namespace d09
 		}
 	};
 
+	static void serialize(Cache::Archive& archive, Data09& data)
+	{
+		archive(data.rawDiskMap, data.blocks);
+	}
+
 	static auto loadData(const char* filename)
 	{
 		std::fstream s{ filename, s.in };
@@ -139,19 +146,9 @@ namespace d09
 		return data.checksum();
 	}
 
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
-	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
-	}
-
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -160,3 +157,5 @@ void day09()
 	d09::processPrintAndAssert("../data/09/test.txt", std::make_pair(1928ull, 2858ull));
 	d09::processPrintAndAssert("../data/09/real.txt", std::make_pair(6299243228569ull, 0ull));
 }
+
+static Days::Registrar registrar(9, day09, [] (const char* filename) { d09::processPrintAndAssert(filename, {}); });
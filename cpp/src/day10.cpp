@@ -12,43 +12,39 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Grid.h"
+#include "Harness.h"
+#include "Parallel.h"
+#include "String.h"
 #include "Vec2.h"
+#include "Vec2Set.h"
 
 namespace d10
 {
+	// Around the map, so that no step off the edge is ever uphill.
+	constexpr uint8_t noHeight = UINT8_MAX;
+
 	struct Data10
 	{
-		std::vector<std::vector<uint8_t>> grid;
-		Bounds bounds;
+		Grid<uint8_t> grid;
 	};
 
-	static auto loadData(const char* filename)
+	static void serialize(Cache::Archive& archive, Data10& data)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		archive(data.grid);
+	}
 
+	static auto loadData(const char* filename)
+	{
 		Data10 data;
 
-		while (s.peek() != EOF)
-		{
-			std::string line;
-			std::getline(s, line);
-
-			std::vector<uint8_t> row;
-			for (char c : line)
-				row.push_back(c - '0');
-
-			data.grid.push_back(std::move(row));
-			assert(data.grid.front().size() == data.grid.back().size());
-		}
-
-		data.bounds.botRght.x = (int) data.grid.front().size();
-		data.bounds.botRght.y = (int) data.grid.size();
+		constexpr int padding = 1;
+		data.grid = Grid<uint8_t>::fromLines(String::Lines(filename), [] (char c, Vec2) { return (uint8_t) (c - '0'); }, padding, noHeight);
 
 		return data;
 	}
 
-	static uint64_t walkTrails(const Data10& data, const Vec2 pos, const uint8_t height, std::set<Vec2>& peaks)
+	static uint64_t walkTrails(const Data10& data, const Vec2 pos, const uint8_t height, Vec2Set& peaks)
 	{
 		if (height == 9)
 		{
@@ -62,64 +58,64 @@ namespace d10
 		for (const Vec2 delta : Vec2::directions)
 		{
 			const Vec2 neighbour = pos + delta;
-			if (data.bounds.isInBounds(neighbour))
-				if (data.grid[neighbour.y][neighbour.x] == next)
-					rating += walkTrails(data, neighbour, next, peaks);
+			if (data.grid[neighbour] == next)
+				rating += walkTrails(data, neighbour, next, peaks);
 		}
 
 		return rating;
 	}
 
+	static std::vector<Vec2> getTrailheads(const Data10& data)
+	{
+		std::vector<Vec2> trailheads;
+		for (int row = 0; row < data.grid.getHeight(); ++row)
+			for (int col = 0; col < data.grid.getWidth(); ++col)
+				if (data.grid[{col, row}] == 0)
+					trailheads.push_back({col, row});
+
+		return trailheads;
+	}
+
 	static uint64_t partOne(const Data10& data)
 	{
-		uint64_t sum = 0;
-		for (int row = 0; row < data.bounds.botRght.y; ++row)
+		const std::vector<Vec2> trailheads = getTrailheads(data);
+
+		return Parallel::reduceChunks(0, trailheads.size(), 0ull, [&] (size_t begin, size_t end)
 		{
-			for (int col = 0; col < data.bounds.botRght.x; ++col)
+			uint64_t sum = 0;
+			Vec2Set peaks;
+			for (size_t i = begin; i < end; ++i)
 			{
-				if (data.grid[row][col] == 0)
-				{
-					std::set<Vec2> peaks;
-					walkTrails(data, {col, row}, 0, peaks);
-					sum += peaks.size();
-				}
+				peaks.clear();
+				walkTrails(data, trailheads[i], 0, peaks);
+				sum += peaks.size();
 			}
-		}
 
-		return sum;
+			return sum;
+		}, std::plus<>());
 	}
 
 	static uint64_t partTwo(const Data10& data)
 	{
-		uint64_t sum = 0;
-		for (int row = 0; row < data.bounds.botRght.y; ++row)
+		const std::vector<Vec2> trailheads = getTrailheads(data);
+
+		return Parallel::reduceChunks(0, trailheads.size(), 0ull, [&] (size_t begin, size_t end)
 		{
-			for (int col = 0; col < data.bounds.botRght.x; ++col)
+			uint64_t sum = 0;
+			Vec2Set peaks;
+			for (size_t i = begin; i < end; ++i)
 			{
-				if (data.grid[row][col] == 0)
-				{
-					std::set<Vec2> peaks;
-					sum += walkTrails(data, {col, row}, 0, peaks);
-				}
+				peaks.clear();
+				sum += walkTrails(data, trailheads[i], 0, peaks);
 			}
-		}
 
-		return sum;
-	}
-
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
-	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
+			return sum;
+		}, std::plus<>());
 	}
 
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -128,3 +124,5 @@ void day10()
 	d10::processPrintAndAssert("../data/10/test.txt", std::make_pair(36ull, 81ull));
 	d10::processPrintAndAssert("../data/10/real.txt", std::make_pair(535ull, 1186ull));
 }
+
+static Days::Registrar registrar(10, day10, [] (const char* filename) { d10::processPrintAndAssert(filename, {}); });
@@ -12,6 +12,12 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Harness.h"
+#include "MappedFile.h"
+#include "Memo.h"
+#include "Parallel.h"
+#include "String.h"
+
 namespace d11
 {
 	struct Data11
@@ -19,24 +25,18 @@ namespace d11
 		std::vector<uint64_t> stones;
 	};
 
+	static void serialize(Cache::Archive& archive, Data11& data)
+	{
+		archive(data.stones);
+	}
+
 	static auto loadData(const char* filename)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		const MappedFile file(filename);
+		assert(file.isOpen());
 
 		Data11 data;
-
-		while (s.peek() != EOF)
-		{
-			std::string line;
-			std::getline(s, line);
-
-			for (const auto word : std::views::split(line, ' '))
-			{
-				const std::string token(&*word.begin(), std::ranges::distance(word));
-				data.stones.push_back(std::stoull(token));
-			}
-		}
+		String::parseInts({file.data(), file.size()}, data.stones);
 
 		return data;
 	}
@@ -48,12 +48,13 @@ namespace d11
 
 		using Key = std::pair<uint64_t, uint64_t>;
 
-		static std::map<Key, uint64_t> memoized;
+		// Counts depend only on the stone and blinks, not the input, so one
+		// table serves every run. Parallel loops over stones share it.
+		static Memo<Key, uint64_t> memoized({.capacity = 1 << 20, .numShards = 16, .name = "d11::getNumStonesAfterNBlinks memo"});
 
 		const Key key{stoneId, n};
-		auto iter = memoized.find(key);
-		if (iter != memoized.end())
-			return iter->second;
+		if (std::optional<uint64_t> count = memoized.find(key))
+			return *count;
 
 		std::optional<uint64_t> leftId;
 		std::optional<uint64_t> rightId;
@@ -85,43 +86,36 @@ namespace d11
 		if (rightId)
 			count += getNumStonesAfterNBlinks(rightId.value(), n - 1);
 
-		memoized[key] = count;
+		memoized.insert(key, count);
 		return count;
 	}
 
 	static uint64_t partOne(const Data11& data)
 	{
-		uint64_t sum = 0;
-		
-		for (uint64_t stone : data.stones)
-			sum += getNumStonesAfterNBlinks(stone, 25);
-
-		return sum;
+		return Parallel::reduce(0, data.stones.size(), 0ull, [&] (size_t i)
+		{
+			return getNumStonesAfterNBlinks(data.stones[i], 25);
+		}, std::plus<>());
 	}
 
 	static uint64_t partTwo(const Data11& data)
 	{
-		uint64_t sum = 0;
-
-		for (uint64_t stone : data.stones)
-			sum += getNumStonesAfterNBlinks(stone, 75);
-
-		return sum;
+		return Parallel::reduce(0, data.stones.size(), 0ull, [&] (size_t i)
+		{
+			return getNumStonesAfterNBlinks(data.stones[i], 75);
+		}, std::plus<>());
 	}
 
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
+	// Every stone soon splits down to single digits, so their counts are most
+	// of what any input looks up.
+	static void warm()
 	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
+		Parallel::forEach(0, 10, [] (size_t stone) { getNumStonesAfterNBlinks(stone, 75); });
 	}
 
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -130,3 +124,5 @@ void day11()
 	d11::processPrintAndAssert("../data/11/test.txt", std::make_pair(55312ull, 65601038650482ull));
 	d11::processPrintAndAssert("../data/11/real.txt", std::make_pair(186203ull, 221291560078593ull));
 }
+
+static Days::Registrar registrar(11, day11, [] (const char* filename) { d11::processPrintAndAssert(filename, {}); }, d11::warm);
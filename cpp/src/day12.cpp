@@ -12,6 +12,7 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Harness.h"
 #include "Vec2.h"
 
 namespace d12
@@ -22,6 +23,11 @@ namespace d12
 		Bounds bounds;
 	};
 
+	static void serialize(Cache::Archive& archive, Data12& data)
+	{
+		archive(data.grid, data.bounds);
+	}
+
 	struct Edge
 	{
 		Vec2 from;
@@ -228,19 +234,9 @@ namespace d12
 		return cost;
 	}
 
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
-	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
-	}
-
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -253,3 +249,5 @@ void day12()
 	d12::processPrintAndAssert("../data/12/test5.txt", std::make_pair(1184ull, 368ull));
 	d12::processPrintAndAssert("../data/12/real.txt", std::make_pair(1434856ull, 891106ull));
 }
+
+static Days::Registrar registrar(12, day12, [] (const char* filename) { d12::processPrintAndAssert(filename, {}); });
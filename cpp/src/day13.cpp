@@ -9,9 +9,13 @@
 #include <ranges>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
+#include "Harness.h"
+#include "Pattern.h"
+#include "String.h"
 #include "Vec2.h"
 
 namespace d13
@@ -90,53 +94,61 @@ namespace d13
 		std::vector<Machine> machines;
 	};
 
-	static auto loadData(const char* filename)
+	static void serialize(Cache::Archive& archive, Data13& data)
 	{
-		static auto readPos = [] (const std::string& line)
-		{
-			const size_t xPos = line.find('X');
-			const size_t yPos = line.find('Y');
-			const int x = std::stol(&line[xPos + 2]);
-			const int y = std::stol(&line[yPos + 2]);
-			return Vec2i64{x, y};
-		};
-
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		archive(data.machines);
+	}
 
-		Data13 data;
+	// Puts machines together from their button A, button B and prize lines.
+	struct MachineParser
+	{
 		Machine machine;
 
-		while (s.peek() != EOF)
+		// Returns the machine once its prize line has been added.
+		std::optional<Machine> add(std::string_view line)
 		{
-			std::string line;
-			std::getline(s, line);
 			if (line.size() == 0)
-				continue;
+				return std::nullopt;
+
+			[[maybe_unused]] bool matched = false;
 
 			if (machine.buttonA == Vec2i64())
 			{
-				machine.buttonA = readPos(line);
+				matched = Pattern::match<"Button A: X+{}, Y+{}">(line, machine.buttonA.x, machine.buttonA.y);
 			}
 			else if (machine.buttonB == Vec2i64())
 			{
-				machine.buttonB = readPos(line);
-			}
-			else if (machine.prize == Vec2i64())
-			{
-				machine.prize = readPos(line);
-				data.machines.push_back(machine);
-				machine = Machine();
+				matched = Pattern::match<"Button B: X+{}, Y+{}">(line, machine.buttonB.x, machine.buttonB.y);
 			}
 			else
 			{
-				assert(false);
+				assert(machine.prize == Vec2i64());
+				matched = Pattern::match<"Prize: X={}, Y={}">(line, machine.prize.x, machine.prize.y);
+				assert(matched);
+				return std::exchange(machine, Machine());
 			}
+
+			assert(matched);
+			return std::nullopt;
+		}
+	};
+
+	static auto loadData(const char* filename)
+	{
+		Data13 data;
+		MachineParser parser;
+
+		for (std::string_view line : String::Lines(filename))
+		{
+			if (std::optional<Machine> machine = parser.add(line))
+				data.machines.push_back(*machine);
 		}
 
 		return data;
 	}
 
+	static constexpr int64_t partTwoOffset = 10'000'000'000'000;
+
 	static uint64_t partOne(const Data13& data)
 	{
 		uint64_t sum = 0;
@@ -152,13 +164,11 @@ namespace d13
 
 	static uint64_t partTwo(const Data13& data)
 	{
-		const int64_t offset = 10'000'000'000'000;
-
 		uint64_t sum = 0;
 
 		for (Machine machine : data.machines)
 		{
-			machine.prize += Vec2i64{offset, offset};
+			machine.prize += Vec2i64{partTwoOffset, partTwoOffset};
 
 			if (std::optional<uint64_t> cost = machine.calculateWinCost())
 				sum += cost.value();
@@ -166,19 +176,38 @@ namespace d13
 
 		return sum;
 	}
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
+
+	struct Reducer
 	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
-	}
+		MachineParser parser;
+		uint64_t sumOne = 0;
+		uint64_t sumTwo = 0;
+
+		void add(std::string_view line)
+		{
+			std::optional<Machine> machine = parser.add(line);
+			if (!machine)
+				return;
+
+			if (std::optional<uint64_t> cost = machine->calculateWinCost())
+				sumOne += cost.value();
+
+			machine->prize += Vec2i64{partTwoOffset, partTwoOffset};
+
+			if (std::optional<uint64_t> cost = machine->calculateWinCost())
+				sumTwo += cost.value();
+		}
+
+		uint64_t partOne() const { return sumOne; }
+		uint64_t partTwo() const { return sumTwo; }
+	};
 
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		if (Stream::isEnabled())
+			Harness::streamPrintAndAssert<Reducer>(filename, expected.first, expected.second);
+		else
+			Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -187,3 +216,5 @@ void day13()
 	d13::processPrintAndAssert("../data/13/test.txt", std::make_pair(480ull, 875318608908ull));
 	d13::processPrintAndAssert("../data/13/real.txt", std::make_pair(39290ull, 73458657399094ull));
 }
+
+static Days::Registrar registrar(13, day13, [] (const char* filename) { d13::processPrintAndAssert(filename, {}); });
@@ -1,4 +1,3 @@
-#include <windows.h>
 #include <algorithm>
 #include <cassert>
 #include <fstream>
@@ -15,6 +14,9 @@
 #include <chrono>
 #include <thread>
 
+#include "Harness.h"
+#include "Pattern.h"
+#include "String.h"
 #include "Vec2.h"
 #include "Renderer.h"
 
@@ -33,39 +35,29 @@ namespace d14
 		Bounds bounds;
 	};
 
-	static auto loadData(const char* filename)
+	static void serialize(Cache::Archive& archive, Data14& data)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		archive(data.robots, data.bounds);
+	}
 
+	static auto loadData(const char* filename)
+	{
 		Data14 data;
 
-		while (s.peek() != EOF)
+		for (std::string_view line : String::Lines(filename))
 		{
-			std::string line;
-			std::getline(s, line);
 			assert(line.size() > 0);
 
 			if (data.bounds.botRght == Vec2())
 			{
-				data.bounds.botRght.x = std::stol(line);
-				data.bounds.botRght.y = std::stol(&line[line.find(',') + 1]);
+				[[maybe_unused]] const bool matched = Pattern::match<"{},{}">(line, data.bounds.botRght.x, data.bounds.botRght.y);
+				assert(matched);
 			}
 			else
 			{
-				assert(line[0] == 'p');
-				assert(line[1] == '=');
-
 				Robot r;
-				r.pos.x = std::stol(&line[2]);
-				
-				auto pos = line.find(',') + 1;
-				r.pos.y = std::stol(&line[pos]);
-
-				pos = line.find('v') + 2;
-				r.vel.x = std::stol(&line[pos]);
-				pos = line.find(',', pos) + 1;
-				r.vel.y = std::stol(&line[pos]);
+				[[maybe_unused]] const bool matched = Pattern::match<"p={},{} v={},{}">(line, r.pos.x, r.pos.y, r.vel.x, r.vel.y);
+				assert(matched);
 
 				const size_t index = data.robots.size();
 				const size_t mod52 = index % 52;
@@ -113,10 +105,10 @@ namespace d14
 		}
 	}
 
-	bool hasContinuousChunk(const Renderer& renderer)
+	bool hasContinuousChunk(const std::vector<std::string>& grid)
 	{
-		for (auto& line : renderer.getBuffer())
-			if (&line != &renderer.getBuffer().back() && line.find("#######") != std::string::npos)
+		for (auto& line : grid)
+			if (&line != &grid.back() && line.find("#######") != std::string::npos)
 				return true;
 
 		return false;
@@ -162,19 +154,19 @@ namespace d14
 
 	static uint64_t partTwo(const Data14& data)
 	{
-		using namespace std::chrono_literals;
-
-		system("cls");
+		const int width = data.bounds.botRght.x;
+		const int height = data.bounds.botRght.y;
 
 		Renderer renderer(data.bounds);
-		std::set<std::string> seen;
+		renderer.clearScreen();
+
+		std::vector<std::string> grid(height, std::string(width, ' '));
 		std::vector<Robot> robots = data.robots;
 
-		for (int i = 1; true; ++i)
+		// Every robot is back where it started after width*height ticks, so
+		// there is nothing new to see after that.
+		for (int i = 1; i <= width * height; ++i)
 		{
-			if (!seen.insert(renderer.concatenated()).second)
-				break; // escape infinite loop
-
 			tick(robots, data.bounds);
 
 			constexpr bool animated = false;
@@ -201,17 +193,23 @@ namespace d14
 					}
 
 					renderer.render();
-					std::this_thread::sleep_for(16ms);
+					renderer.sleep(16);
 				}
 			}
 			else
 			{
-				renderer.clear();
+				for (std::string& line : grid)
+					std::fill(line.begin(), line.end(), ' ');
+
 				for (const Robot& robot : robots)
-					renderer.plot(robot.pos, robot.glyph);
-		
-				if (hasContinuousChunk(renderer))
+					grid[robot.pos.y][robot.pos.x] = '#';
+
+				if (hasContinuousChunk(grid))
 				{
+					renderer.clear();
+					for (const Robot& robot : robots)
+						renderer.plot(robot.pos, robot.glyph);
+
 					renderer.render();
 
 					//if (std::cin.get() == 'y')
@@ -223,24 +221,16 @@ namespace d14
 		return 0;
 	}
 
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
-	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
-	}
-
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
 void day14()
 {
 	d14::processPrintAndAssert("../data/14/test.txt", std::make_pair(12ull, 0ull));
-	d14::processPrintAndAssert("../data/14/real.txt", std::make_pair(211692000ull, 6586ull));
+	d14::processPrintAndAssert("../data/14/real.txt", std::make_pair(211692000ull, 6587ull));
 }
+
+static Days::Registrar registrar(14, day14, [] (const char* filename) { d14::processPrintAndAssert(filename, {}); });
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <functional>
 #include <map>
+#include <memory_resource>
 #include <numeric>
 #include <optional>
 #include <ranges>
@@ -12,6 +13,10 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Arena.h"
+#include "Grid.h"
+#include "Harness.h"
+#include "String.h"
 #include "Vec2.h"
 #include "Renderer.h"
 
@@ -27,49 +32,46 @@ namespace d15
 
 	struct Data15
 	{
-		std::vector<std::vector<EntityType>> grid;
+		::Grid<EntityType> grid;
 		std::vector<Direction> instructions;
-		Bounds bounds;
 	};
 
-	static auto loadData(const char* filename)
+	static void serialize(Cache::Archive& archive, Data15& data)
+	{
+		archive(data.grid, data.instructions);
+	}
+
+	static EntityType toEntityType(char c, Vec2)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		if (c == '#')
+			return EntityType::Wall;
+		else if (c == '.')
+			return EntityType::None;
+		else if (c == 'O')
+			return EntityType::Box;
+		else if (c == '@')
+			return EntityType::Robot;
+
+		assert(false);
+		return EntityType::None;
+	}
 
+	static auto loadData(const char* filename)
+	{
 		Data15 data;
+		const String::Lines lines(filename);
+		std::vector<std::string_view> gridLines;
 		bool processGrid = true;
 
-		while (s.peek() != EOF)
+		for (std::string_view line : lines)
 		{
-			std::string line;
-			std::getline(s, line);
-
 			if (line.size() == 0)
 			{
 				processGrid = false;
 			}
 			else if (processGrid)
 			{
-				data.grid.push_back({});
-
-				std::vector<EntityType>& row = data.grid.back();
-
-				for (char c : line)
-				{
-					if (c == '#')
-						row.push_back(EntityType::Wall);
-					else if (c == '.')
-						row.push_back(EntityType::None);
-					else if (c == 'O')
-						row.push_back(EntityType::Box);
-					else if (c == '@')
-						row.push_back(EntityType::Robot);
-					else
-						assert(false);
-				}
-
-				assert(data.grid.front().size() == data.grid.back().size());
+				gridLines.push_back(line);
 			}
 			else
 			{
@@ -89,7 +91,7 @@ namespace d15
 			}
 		}
 
-		data.bounds.botRght = {(int) data.grid.front().size(), (int) data.grid.size() };
+		data.grid = ::Grid<EntityType>::fromLines(gridLines, toEntityType);
 
 		return data;
 	}
@@ -111,7 +113,7 @@ namespace d15
 		std::unique_ptr<Renderer> renderer;
 
 		explicit Grid(const Data15& data, bool doubleWidth)
-			: bounds(data.bounds)
+			: bounds{{0, 0}, {data.grid.getWidth(), data.grid.getHeight()}}
 			, isDoubleWidth(doubleWidth)
 		{
 			if (doubleWidth)
@@ -119,11 +121,11 @@ namespace d15
 
 			renderer = std::make_unique<Renderer>(bounds);
 
-			for (int y = 0; y < (int) data.grid.size(); ++y)
+			for (int y = 0; y < data.grid.getHeight(); ++y)
 			{
-				for (int x = 0; x < (int) data.grid.front().size(); ++x)
+				for (int x = 0; x < data.grid.getWidth(); ++x)
 				{
-					const EntityType type = data.grid[y][x];
+					const EntityType type = data.grid[{x, y}];
 					const Vec2 pos = doubleWidth ? Vec2{x*2, y} : Vec2{x, y};
 
 					switch (type)
@@ -186,8 +188,8 @@ namespace d15
 		{
 			const bool isVertical = (delta.x == 0);
 
-			std::set<Entity*> pushedBoxes;
-			std::vector<Vec2> posQueue;
+			std::pmr::set<Entity*> pushedBoxes(Arena::current());
+			std::pmr::vector<Vec2> posQueue(Arena::current());
 			posQueue.push_back(robot->pos + delta);
 
 			for (size_t i = 0; i < posQueue.size(); ++i)
@@ -278,10 +280,16 @@ namespace d15
 		{
 			//renderer->clearScreen();
 
+			// Each move's scratch is gone by the next.
+			Arena arena;
+
 			for (const Direction dir : instructions)
 			{
 				moveRobot(Vec2::getDirection(dir));
-				//render();
+				arena.reset();
+
+				if (renderer->isRecording())
+					render();
 			}
 
 			return sumBoxGPSCoords();
@@ -300,19 +308,9 @@ namespace d15
 		return Grid(data, doubleWidth).execute(data.instructions);
 	}
 
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
-	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
-	}
-
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
@@ -322,3 +320,5 @@ void day15()
 	d15::processPrintAndAssert("../data/15/test2.txt", std::make_pair(2028ull, 1751ull));
 	d15::processPrintAndAssert("../data/15/real.txt", std::make_pair(1406628ull, 1432781ull));
 }
+
+static Days::Registrar registrar(15, day15, [] (const char* filename) { d15::processPrintAndAssert(filename, {}); });
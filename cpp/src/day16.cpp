@@ -14,51 +14,45 @@
 #include <unordered_map>
 #include <queue>
 
+#include "Days.h"
+#include "Grid.h"
+#include "Harness.h"
+#include "PathSearch.h"
+#include "Stats.h"
+#include "String.h"
 #include "Vec2.h"
+#include "Vec2Set.h"
 #include "Renderer.h"
 
 namespace d16
 {
 	struct Data16
 	{
-		std::vector<std::vector<bool>> grid;
+		Grid<uint8_t> grid; // walls
 		Vec2 startPos;
 		Vec2 endPos;
 	};
 
-	static auto loadData(const char* filename)
+	static void serialize(Cache::Archive& archive, Data16& data)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		archive(data.grid, data.startPos, data.endPos);
+	}
 
+	static auto loadData(const char* filename)
+	{
 		Data16 data;
 
-		while (s.peek() != EOF)
+		auto toWall = [&] (char c, Vec2 pos)
 		{
-			std::string line;
-			std::getline(s, line);
-			assert(line.size() > 0);
+			if (c == 'S')
+				data.startPos = pos;
+			else if (c == 'E')
+				data.endPos = pos;
 
-			data.grid.push_back({});
+			return (uint8_t) (c == '#');
+		};
 
-			for (char c : line)
-			{
-				const bool wall = (c == '#');
-				data.grid.back().push_back(wall);
-
-				const Vec2 pos = {
-					(int) data.grid.back().size() - 1,
-					(int) data.grid.size() - 1
-				};
-
-				if (c == 'S')
-					data.startPos = pos;
-				else if (c == 'E')
-					data.endPos = pos;
-			}
-
-			assert(data.grid.front().size() == data.grid.back().size());
-		}
+		data.grid = Grid<uint8_t>::fromLines(String::Lines(filename), toWall);
 
 		return data;
 	}
@@ -67,57 +61,32 @@ namespace d16
 	{
 		Vec2 pos;
 		Direction dir = Direction::Count;
-		uint64_t score = 0;
 
 		Location getRotateLeft() const
 		{
-			Location loc = *this;
-			loc.score += 1000;
-			loc.dir = Direction(((int) dir + 3) % 4);
-			return loc;
+			return {pos, Direction(((int) dir + 3) % 4)};
 		}
 
 		Location getRotateRight() const
 		{
-			Location loc = *this;
-			loc.score += 1000;
-			loc.dir = Direction(((int) dir + 1) % 4);
-			return loc;
+			return {pos, Direction(((int) dir + 1) % 4)};
 		}
 
 		Location getForward() const
 		{
-			Location loc = *this;
-			loc.score += 1;
-			loc.pos += Vec2::getDirection(dir);
-			return loc;
-		}
-
-		bool operator==(const Location& r) const { return pos == r.pos && dir == r.dir && score == r.score; }
-		bool operator!=(const Location& r) const { return !(*this == r); }
-		bool operator<(const Location& r) const
-		{
-			if (pos != r.pos) return pos < r.pos;
-			if (dir != r.dir) return dir < r.dir;
-			//if (score != r.score) return score < r.score;
-			return false;
+			return {pos + Vec2::getDirection(dir), dir};
 		}
 	};
 
-	struct MoreExpensive
-	{
-		bool operator()(const Location& l, const Location& r) const
-		{
-			return l.score > r.score;
-		}
-	};
+	constexpr uint64_t forwardCost = 1;
+	constexpr uint64_t rotateCost = 1000;
 
 	void renderGrid(Renderer& renderer, const Data16& data, const Location& loc)
 	{
 		renderer.clear();
-		for (int y = 0; y < (int) data.grid.size(); ++y)
+		for (int y = 0; y < data.grid.getHeight(); ++y)
 		{
-			for (int x = 0; x < (int) data.grid.front().size(); ++x)
+			for (int x = 0; x < data.grid.getWidth(); ++x)
 			{
 				const Vec2 pos{x, y};
 				if (pos == loc.pos)
@@ -135,7 +104,7 @@ namespace d16
 					renderer.plot(pos, 'S');
 				else if (pos == data.endPos)
 					renderer.plot(pos, 'E');
-				else if (data.grid[y][x])
+				else if (data.grid[pos])
 					renderer.plot(pos, '#');
 				else
 					renderer.plot(pos, '.');
@@ -145,220 +114,163 @@ namespace d16
 		renderer.waitForInput();
 	}
 
-	struct Edge
-	{
-		Vec2 from{-1,-1};
-		Vec2 to{-1,-1};
-		uint64_t score = 0;
-	};
-
-	struct Node
+	static void unittest_aStarBuckets()
 	{
-		std::vector<Edge> inEdges;
-		std::vector<Edge> outEdges;
+		// Along a line from 0 to 20, stepping 1 for 1 or 2 for 3. The
+		// heuristic starts at 20, far above the most a move can cost, so the
+		// bucket queue has to count up from there rather than from 0.
+		constexpr int goal = 20;
 
-		uint64_t getMaxOutVisitedScore(const std::set<Vec2>& visited) const
-		{
-			uint64_t score = 0;
-			for (const Edge& e : outEdges)
-				if (visited.find(e.to) != visited.end())
-					score = std::max(score, e.score);
+		auto search = PathSearch::makeSearch<int, int>(goal + 1, [] (int pos) { return (size_t) pos; });
+		search.setMaxMoveCost(3);
 
-			return score;
-		}
-
-		uint64_t getMinInScore() const
+		auto neighbours = [] (int pos, auto&& visit)
 		{
-			uint64_t score = UINT64_MAX;
-			for (const Edge& e : inEdges)
-				score = std::min(score, e.score);
+			if (pos + 1 <= goal)
+				visit(pos + 1, 1);
+			if (pos + 2 <= goal)
+				visit(pos + 2, 3);
+		};
 
-			return score;
-		}
+		const std::optional<int> cost = search.run<PathSearch::Mode::AStar, PathSearch::QueueType::Buckets>(0, neighbours,
+			[] (int pos) { return pos == goal; },
+			[] (int pos) { return goal - pos; });
 
-	};
+		assert(cost == goal);
+	}
 
-	struct PathFinder
+	static auto findCheapestPaths(const Data16& data, bool keepPredecessors)
 	{
-		Location finalLocation;
-		std::vector<std::vector<Node>> nodes;
-
-		void pathFind(const Data16& data)
-		{
-			nodes.resize(data.grid.size(), std::vector<Node>(data.grid.front().size()));
+		STATS_SCOPED_TIMER("d16::findCheapestPaths");
 
-			std::priority_queue<Location, std::vector<Location>, MoreExpensive> queue;
+		const int width = data.grid.getWidth();
+		auto index = [width] (const Location& loc) { return ((size_t) loc.pos.y * width + loc.pos.x) * 4 + (size_t) loc.dir; };
 
-			queue.push({data.startPos, Direction::Right, 0});
+		auto search = PathSearch::makeSearch<Location, uint64_t>((size_t) width * data.grid.getHeight() * 4, index, keepPredecessors);
+		search.setMaxMoveCost(rotateCost);
 
-			std::set<Location> visited;
-
-			Renderer renderer(data.grid.front().size(), data.grid.size());
-
-			while (true)
-			{
-				const Location loc = queue.top();
-				queue.pop();
-
-				if (finalLocation.dir != Direction::Count
-					&& finalLocation.score < loc.score)
-					break; // stop searching, paths are now longer.
+		auto neighbours = [&] (const Location& loc, auto&& visit)
+		{
+			STATS_COUNT("d16::findCheapestPaths locations expanded");
 
-				if (visited.insert(loc).second)
-				{
-					if (data.grid[loc.pos.y][loc.pos.x])
-						continue; // wall
+			visit(loc.getRotateLeft(), rotateCost);
+			visit(loc.getRotateRight(), rotateCost);
 
-					if (loc.pos == data.endPos)
-					{
-						finalLocation = loc; // found end
-						continue; // keep searching to find other paths to end.
-					}
+			const Location forward = loc.getForward();
+			if (!data.grid[forward.pos])
+				visit(forward, forwardCost);
+		};
 
-					// generate iterations
-					const Location left = loc.getRotateLeft();
-					const Location right = loc.getRotateRight();
-					const Location forward = loc.getForward();
+		auto isGoal = [&] (const Location& loc) { return loc.pos == data.endPos; };
 
-					queue.push(left);
-					queue.push(right);
+		const std::optional<uint64_t> score = search.run<PathSearch::Mode::Dijkstra, PathSearch::QueueType::Buckets>({data.startPos, Direction::Right}, neighbours, isGoal);
+		assert(score);
 
-					// if forward is not a wall
-					if (!data.grid[forward.pos.y][forward.pos.x])
-					{
-						queue.push(forward);
+		return std::make_pair(*score, std::move(search));
+	}
 
-						Node& node = nodes[loc.pos.y][loc.pos.x];
-						Node& nextNode = nodes[forward.pos.y][forward.pos.x];
+	static std::vector<Location> getEndLocations(const Data16& data)
+	{
+		std::vector<Location> ends;
+		for (Direction dir = Direction::First; dir != Direction::Count; dir = Direction((int) dir + 1))
+			ends.push_back({data.endPos, dir});
 
-						const Edge edge = {loc.pos, forward.pos, forward.score};
-						node.outEdges.push_back(edge);
-						nextNode.inEdges.push_back(edge);
-					}
-				}
-				//renderGrid(renderer, data, loc);
-			}
-		}
-	};
+		return ends;
+	}
 
 	static uint64_t partOne(const Data16& data)
 	{
-		PathFinder finder;
-		finder.pathFind(data);
-		return finder.finalLocation.score;
+		constexpr bool keepPredecessors = false;
+		return findCheapestPaths(data, keepPredecessors).first;
 	}
 
 	static uint64_t partTwo(const Data16& data)
 	{
-		PathFinder finder;
-		finder.pathFind(data);
+		constexpr bool keepPredecessors = true;
+		const auto [score, search] = findCheapestPaths(data, keepPredecessors);
 
-		const Bounds bounds{{0,0}, {(int) data.grid.front().size(), (int) data.grid.size()}};
-		uint64_t numTiles = 0;
-
-		std::vector<Vec2> searchQueue;
-		std::set<Vec2> visited;
-		searchQueue.push_back(finder.finalLocation.pos);
+		const Bounds bounds{{0,0}, {data.grid.getWidth(), data.grid.getHeight()}};
 
 		Renderer renderer(bounds);
 		const int scoreWidth = 6;
 		Renderer rendererScores(bounds.botRght.x * scoreWidth, bounds.botRght.y);
 
-		for (int y = 0; y < (int) data.grid.size(); ++y)
+		// Only worth filling in when someone can see it.
+		if constexpr (Renderer::isEnabled)
 		{
-			for (int x = 0; x < (int) data.grid.front().size(); ++x)
+			for (int y = 0; y < data.grid.getHeight(); ++y)
 			{
-				const Vec2 pos{x, y};
-
+				for (int x = 0; x < data.grid.getWidth(); ++x)
 				{
-					if (pos == data.startPos)
-						renderer.plot(pos, 'S');
-					else if (pos == data.endPos)
-						renderer.plot(pos, 'E');
-					else 
-						if (data.grid[y][x])
-						//renderer.plot(pos, '#');
-						renderer.plot(pos, (int) 219 - 256);
-					else
-						renderer.plot(pos, ' ');
-				}
+					const Vec2 pos{x, y};
 
-				const uint64_t score = finder.nodes[pos.y][pos.x].getMinInScore();
-				const bool isScoreSet = score != UINT64_MAX;
-				const std::string scoreStr = isScoreSet ? std::to_string(score) : std::string();
+					{
+						if (pos == data.startPos)
+							renderer.plot(pos, 'S');
+						else if (pos == data.endPos)
+							renderer.plot(pos, 'E');
+						else 
+							if (data.grid[pos])
+							//renderer.plot(pos, '#');
+							renderer.plot(pos, (int) 219 - 256);
+						else
+							renderer.plot(pos, ' ');
+					}
 
-				for (int i = 0; i < scoreWidth; ++i)
-				{
-					const Vec2 scorePos{x*scoreWidth + i, y};
-					if (i == scoreWidth - 1)
-						rendererScores.plot(scorePos, ' ');
-					else if (pos == data.startPos)
-						rendererScores.plot(scorePos, 'S');
-					else if (pos == data.endPos)
-						rendererScores.plot(scorePos, 'E');
-					else if (data.grid[y][x])
-						rendererScores.plot(scorePos, '#');
-					else if (isScoreSet)
-						rendererScores.plot(scorePos, i < (int) scoreStr.size() ? scoreStr[i] : ' ');
-					else
-						rendererScores.plot(scorePos, '.');
+					uint64_t cost = search.unreached;
+					for (Direction dir = Direction::First; dir != Direction::Count; dir = Direction((int) dir + 1))
+						cost = std::min(cost, search.getCost({pos, dir}));
+
+					const bool isScoreSet = cost != search.unreached;
+					const std::string scoreStr = isScoreSet ? std::to_string(cost) : std::string();
+
+					for (int i = 0; i < scoreWidth; ++i)
+					{
+						const Vec2 scorePos{x*scoreWidth + i, y};
+						if (i == scoreWidth - 1)
+							rendererScores.plot(scorePos, ' ');
+						else if (pos == data.startPos)
+							rendererScores.plot(scorePos, 'S');
+						else if (pos == data.endPos)
+							rendererScores.plot(scorePos, 'E');
+						else if (data.grid[pos])
+							rendererScores.plot(scorePos, '#');
+						else if (isScoreSet)
+							rendererScores.plot(scorePos, i < (int) scoreStr.size() ? scoreStr[i] : ' ');
+						else
+							rendererScores.plot(scorePos, '.');
+					}
 				}
 			}
 		}
 
-		for (size_t i = 0; i < searchQueue.size(); ++i)
+		Vec2Set tiles;
+		search.forEachOnCheapestPaths(getEndLocations(data), [&] (const Location& loc)
 		{
-			const Vec2 pos = searchQueue[i];
-
-			if (!visited.insert(pos).second)
-				continue;
-
-			++numTiles;
-			//renderer.plot(pos, 'O');
-			renderer.plot(pos, (char) (250 - 256));
-			
-			const Node& node = finder.nodes[pos.y][pos.x];
-			const uint64_t currScore = pos == finder.finalLocation.pos ? finder.finalLocation.score : node.getMaxOutVisitedScore(visited);
-			assert(currScore != 0);
-
-			for (const Edge& e : node.inEdges)
-			{
-				if (e.score <= currScore)
-					searchQueue.push_back(e.from);
-			}
-		}
+			if (tiles.insert(loc.pos))
+				renderer.plot(loc.pos, (char) (250 - 256));
+		});
 
 		renderer.clearScreen();
 		renderer.render();
 		rendererScores.render(false);
-
-		if (numTiles == 505)
-			std::cout << "BUG BUG BUG: An extra path near the start was chosen as a valid path but is incorrect." << '\n';
-
 		renderer.waitForInput();
 
-		return numTiles;
-	}
-
-	static std::pair<uint64_t, uint64_t> process(const char* filename)
-	{
-		const auto data = loadData(filename);
-		return std::make_pair(partOne(data), partTwo(data));
+		return tiles.size();
 	}
 
 	static void processPrintAndAssert(const char* filename, std::pair<uint64_t, uint64_t> expected)
 	{
-		const auto result = process(filename);
-		std::cout << "Part 1: " << result.first << " Part 2: " << result.second << std::endl;
-
-		assert(expected.first == 0 || result.first == expected.first);
-		assert(expected.second == 0 || result.second == expected.second);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected.first, expected.second);
 	}
 }
 
 void day16()
 {
+	d16::unittest_aStarBuckets();
 	d16::processPrintAndAssert("../data/16/test.txt", std::make_pair(7036ull, 45ull));
 	d16::processPrintAndAssert("../data/16/test2.txt", std::make_pair(11048ull, 64ull));
 	d16::processPrintAndAssert("../data/16/real.txt", std::make_pair(99448ull, 498ull));
 }
+
+static Days::Registrar registrar(16, day16, [] (const char* filename) { d16::processPrintAndAssert(filename, {}); });
@@ -12,6 +12,11 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Days.h"
+#include "Harness.h"
+#include "Pattern.h"
+#include "String.h"
+
 namespace d17
 {
 	struct Program
@@ -50,6 +55,11 @@ namespace d17
 		}
 	};
 
+	static void serialize(Cache::Archive& archive, Program& program)
+	{
+		archive(program.registerA, program.registerB, program.registerC, program.program, program.instructions);
+	}
+
 	struct Processor
 	{
 		uint64_t registerA = 0;
@@ -222,36 +232,33 @@ namespace d17
 		Program program;
 	};
 
-	static auto loadData(const char* filename)
+	static void serialize(Cache::Archive& archive, Data17& data)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		archive(data.program);
+	}
 
-		std::vector<std::string> lines;
+	static auto loadData(const char* filename)
+	{
+		const String::Lines file(filename);
+		std::vector<std::string_view> lines;
 
-		while (s.peek() != EOF)
-		{
-			std::string line;
-			std::getline(s, line);
-	
+		for (std::string_view line : file)
 			if (!line.empty())
-				lines.push_back(std::move(line));
-		}
+				lines.push_back(line);
 
 		assert(lines.size() == 4);
 
-		auto readRegister = [] (const std::string& line)
-		{
-			const size_t pos = line.find(':');
-			return std::stoull(&line[pos + 2]);
-		};
-
 		Data17 data;
-		data.program.registerA = readRegister(lines[0]);
-		data.program.registerB = readRegister(lines[1]);
-		data.program.registerC = readRegister(lines[2]);
-		data.program.program = lines[3].substr(lines[3].find(' ') + 1);
-		data.program.load();
+		Program& program = data.program;
+
+		[[maybe_unused]] const bool matched =
+			Pattern::match<"Register A: {}">(lines[0], program.registerA)
+			&& Pattern::match<"Register B: {}">(lines[1], program.registerB)
+			&& Pattern::match<"Register C: {}">(lines[2], program.registerC)
+			&& Pattern::match<"Program: {}">(lines[3], program.program);
+		assert(matched);
+
+		program.load();
 
 		return data;
 	}
@@ -271,6 +278,11 @@ namespace d17
 
 		while (true)
 		{
+			// The program's last digit must come from an A of one octal digit.
+			// If none of 0-7 outputs it, the program is no quine.
+			if (isFirstIteration && prog.registerA >= 8)
+				return 0;
+
 			Processor proc;
 			proc.execute(prog);
 
@@ -284,7 +296,7 @@ namespace d17
 				}
 				else
 				{
-					std::cout
+					Days::out()
 						<< "A: " << prog.registerA
 						<< " Output: " << proc.output 
 						<< std::endl;
@@ -316,14 +328,11 @@ namespace d17
 
 	static void processPrintAndAssert(const char* filename, const std::string& expected1, uint64_t expected2)
 	{
-		const auto data = loadData(filename);
-		const auto result1 = partOne(data);
-		const auto result2 = expected2 != UINT64_MAX ? partTwo(data) : 0ull;
+		// The first test program is not a quine, so there is no part two answer to search for.
+		const bool runPartTwo = expected2 != UINT64_MAX;
+		const auto partTwoIfExpected = [=] (const Data17& data) { return runPartTwo ? partTwo(data) : 0ull; };
 
-		std::cout << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
-
-		assert(expected1 == "" || result1 == expected1);
-		assert(expected2 == 0 || expected2 == UINT64_MAX || result2 == expected2);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwoIfExpected, expected1, runPartTwo ? expected2 : 0ull);
 	}
 }
 
@@ -334,3 +343,5 @@ void day17()
 	d17::processPrintAndAssert("../data/17/test2.txt", "5,7,3,0",             117440ull);
 	d17::processPrintAndAssert("../data/17/real.txt",  "7,4,2,0,5,0,5,3,7",   202991746427434ull);
 }
+
+static Days::Registrar registrar(17, day17, [] (const char* filename) { d17::processPrintAndAssert(filename, std::string(), 0ull); });
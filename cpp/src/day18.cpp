@@ -13,6 +13,11 @@
 #include <unordered_map>
 #include <queue>
 
+#include "BitGrid.h"
+#include "Days.h"
+#include "Harness.h"
+#include "Stats.h"
+#include "String.h"
 #include "Vec2.h"
 #include "Renderer.h"
 
@@ -25,49 +30,38 @@ namespace d18
 		uint32_t partOneCorruptionCount = 0;
 	};
 
-	static auto loadData(const char* filename)
+	static void serialize(Cache::Archive& archive, Data18& data)
 	{
-		std::fstream s{ filename, s.in };
-		assert(s.is_open());
+		archive(data.corrupted, data.bounds, data.partOneCorruptionCount);
+	}
 
+	static auto loadData(const char* filename)
+	{
 		Data18 data;
 		int row = 0;
+		std::vector<int> numbers;
 
-		while (s.peek() != EOF)
+		for (std::string_view line : String::Lines(filename))
 		{
-			std::string line;
-			std::getline(s, line);
 			assert(line.size() > 0);
 
+			numbers.clear();
+			String::parseInts(line, numbers);
+
 			if (row == 0)
 			{
-				std::vector<int> coords;
-
-				for (const auto word : std::views::split(line, '*'))
-				{
-					const std::string token(&*word.begin(), std::ranges::distance(word));
-					coords.push_back(std::stol(token) + 1);
-				}
-
-				assert(coords.size() == 2);
-				data.bounds.botRght = Vec2{coords[0], coords[1]};
+				assert(numbers.size() == 2);
+				data.bounds.botRght = Vec2{numbers[0] + 1, numbers[1] + 1};
 			}
 			else if (row == 1)
 			{
-				data.partOneCorruptionCount = std::stol(line);
+				assert(numbers.size() == 1);
+				data.partOneCorruptionCount = numbers[0];
 			}
 			else
 			{
-				std::vector<int> coords;
-
-				for (const auto word : std::views::split(line, ','))
-				{
-					const std::string token(&*word.begin(), std::ranges::distance(word));
-					coords.push_back(std::stol(token));
-				}
-
-				assert(coords.size() == 2);
-				data.corrupted.emplace_back(Vec2{coords[0], coords[1]});
+				assert(numbers.size() == 2);
+				data.corrupted.emplace_back(Vec2{numbers[0], numbers[1]});
 			}
 
 			++row;
@@ -78,46 +72,35 @@ namespace d18
 
 	struct Grid
 	{
-		std::vector<std::vector<bool>> corrupted;
-		std::vector<std::vector<int>> distances;
-		Bounds bounds;
+		BitGrid corrupted;
 		int width;
 		int height;
 
 		explicit Grid(Bounds bounds)
-			: bounds(bounds)
+			: corrupted(bounds.botRght.x, bounds.botRght.y)
 			, width(bounds.botRght.x)
 			, height(bounds.botRght.y)
 		{
-			corrupted = std::vector<std::vector<bool>>(height, std::vector<bool>(width, false));
-			distances = std::vector<std::vector<int>>(height, std::vector<int>(width, false));
-		}
-
-		void resetScores()
-		{
-			distances = std::vector<std::vector<int>>(height, std::vector<int>(width, false));
 		}
 
 		void corrupt(Vec2 pos)
 		{
-			corrupted[pos.y][pos.x] = true;
+			corrupted.set(pos);
 		}
 
 		bool isCorrupted(Vec2 pos) const
 		{
-			return corrupted[pos.y][pos.x];
+			return corrupted[pos];
 		}
 
-		void setScore(Vec2 pos, int score)
+		std::optional<int> findDistanceToExit() const
 		{
-			distances[pos.y][pos.x] = score;
-		}
+			STATS_SCOPED_TIMER("d18::Grid::findDistanceToExit");
+			STATS_COUNT("d18::Grid::findDistanceToExit searches");
 
-		int getScore(Vec2 pos) const
-		{
-			return distances[pos.y][pos.x];
+			return BitSearch(corrupted, {0, 0}).findDistance({width - 1, height - 1});
 		}
-		
+
 		void render(Renderer& renderer) const
 		{
 			for (int y = 0; y < height; ++y)
@@ -125,7 +108,7 @@ namespace d18
 				for (int x = 0; x < width; ++x)
 				{
 					const Vec2 pos{x, y};
-					if (corrupted[y][x])
+					if (corrupted[pos])
 						renderer.plot(pos, '#');
 					else
 						renderer.plot(pos, '.');
@@ -134,93 +117,20 @@ namespace d18
 		}
 	};
 
-	struct Location
-	{
-		Vec2 pos;
-		int score = 0;
-
-		bool operator==(const Location& r) const { return pos == r.pos && score == r.score; }
-		bool operator!=(const Location& r) const { return !(*this == r); }
-		bool operator<(const Location& r) const { return pos < r.pos; }
-	};
-
-	struct MoreExpensive
-	{
-		bool operator()(const Location& l, const Location& r) const
-		{
-			return l.score > r.score;
-		}
-	};
-
-	struct PathFinder
+	void renderGridAndReached(const Grid& grid)
 	{
-		Location finalLocation;
+		BitSearch search(grid.corrupted, {0, 0});
+		search.findDistance({grid.width - 1, grid.height - 1});
 
-		bool pathFind(Grid& grid)
-		{
-			std::priority_queue<Location, std::vector<Location>, MoreExpensive> queue;
-
-			queue.push({{0,0}, 0});
-
-			std::set<Vec2> visited;
-			const Vec2 target = {grid.width - 1, grid.height - 1};
-
-			while (!queue.empty())
-			{
-				const Location loc = queue.top();
-				queue.pop();
-
-				if (visited.insert(loc.pos).second)
-				{
-					assert(grid.getScore(loc.pos) == 0);
-					grid.setScore(loc.pos, loc.score);
-
-					if (loc.pos == target)
-					{
-						finalLocation = loc; // found end
-						return true;
-					}
-
-					// generate iterations
-					for (Vec2 dir : Vec2::directions)
-					{
-						const Location next = {loc.pos + dir, loc.score + 1};
-						if (grid.bounds.isInBounds(next.pos)
-							&& !grid.isCorrupted(next.pos)
-							&& grid.getScore(next.pos) == 0)
-							queue.push(next);
-					}
-				}
-			}
-
-			return false;
-		}
-	};
-
-	void renderGridAndPath(const Grid& grid, Vec2 startPos, int score)
-	{
 		Renderer renderer(grid.width, grid.height);
 		renderer.clearScreen();
 		grid.render(renderer);
 
-		Vec2 pos = startPos;
-		renderer.plot(pos, 'O');
-		for (int i = score - 1; i >= 0; --i)
-		{
-			Vec2 curr = pos;
-			for (Vec2 dir : Vec2::directions)
-			{
-				const Vec2 next = pos + dir;
-				if (grid.bounds.isInBounds(pos + dir)
-					&& !grid.isCorrupted(next)
-					&& grid.getScore(next) == i)
-				{
-					pos = next;
-					renderer.plot(pos, 'O');
-				}
-			}
-			assert(curr != pos);
-		}
+		for (int y = 0; y < grid.height; ++y)
+			for (int x = 0; x < grid.width; ++x)
+				if (search.getReached()[{x, y}])
+					renderer.plot({x, y}, 'O');
+
 		renderer.render();
 		renderer.waitForInput();
 	}
@@ -232,44 +142,42 @@ namespace d18
 		for (uint32_t i = 0; i < data.partOneCorruptionCount; ++i)
 			grid.corrupt(data.corrupted[i]);
 
-		PathFinder pathFinder;
-		pathFinder.pathFind(grid);
+		//renderGridAndReached(grid);
 
-		const Location finalLoc = pathFinder.finalLocation;
-		//renderGridAndPath(grid, finalLoc.pos, finalLoc.score);
-
-		return finalLoc.score;
+		return grid.findDistanceToExit().value();
 	}
 
 	static std::string partTwo(const Data18& data)
 	{
-		Grid grid(data.bounds);
+		// Once the exit is cut off it stays cut off, so binary search for the
+		// fewest bytes that do it.
+		size_t reachable = 0;
+		size_t blocked = data.corrupted.size() + 1;
 
-		//int attempt = 0;
-		for (Vec2 pos : data.corrupted)
+		while (blocked - reachable > 1)
 		{
-			//std::cout << "Attempt: " << attempt++ << std::endl;
+			const size_t count = reachable + (blocked - reachable) / 2;
 
-			grid.corrupt(pos);
-			grid.resetScores();
+			Grid grid(data.bounds);
+			for (size_t i = 0; i < count; ++i)
+				grid.corrupt(data.corrupted[i]);
 
-			if (!PathFinder().pathFind(grid))
-				return std::to_string(pos.x) + "," + std::to_string(pos.y);
+			if (grid.findDistanceToExit())
+				reachable = count;
+			else
+				blocked = count;
 		}
 
-		return "";
+		if (blocked > data.corrupted.size())
+			return "";
+
+		const Vec2 pos = data.corrupted[blocked - 1];
+		return std::to_string(pos.x) + "," + std::to_string(pos.y);
 	}
 
 	static void processPrintAndAssert(const char* filename, auto expected1, auto expected2)
 	{
-		const auto data = loadData(filename);
-		const auto result1 = partOne(data);
-		const auto result2 = partTwo(data);
-
-		std::cout << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
-
-		assert(expected1 == decltype(expected1){} || result1 == expected1);
-		assert(expected2 == decltype(expected2){} || result2 == expected2);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected1, expected2);
 	}
 }
 
@@ -278,3 +186,5 @@ void day18()
 	d18::processPrintAndAssert("../data/18/test.txt", 22ull, "6,1");
 	d18::processPrintAndAssert("../data/18/real.txt", 280ull, "28,56");
 }
+
+static Days::Registrar registrar(18, day18, [] (const char* filename) { d18::processPrintAndAssert(filename, 0ull, std::string()); });
@@ -12,6 +12,9 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Harness.h"
+#include "Memo.h"
+#include "Parallel.h"
 #include "String.h"
 
 namespace d19
@@ -22,11 +25,16 @@ namespace d19
 		std::vector<std::string> designs;
 	};
 
+	static void serialize(Cache::Archive& archive, Data19& data)
+	{
+		archive(data.towels, data.designs);
+	}
+
 	static auto loadData(const char* filename)
 	{
 		Data19 data;
 
-		for (std::string& line : String::readLines(filename))
+		for (std::string_view line : String::Lines(filename))
 		{
 			if (line.empty())
 				continue;
@@ -34,69 +42,64 @@ namespace d19
 			if (data.towels.empty())
 				data.towels = String::delimit(line, ", ");
 			else
-				data.designs.push_back(std::move(line));
+				data.designs.emplace_back(line);
 		}
 
 		return data;
 	}
 
-	uint64_t solve(const Data19& data, const std::string& design, size_t pos)
-	{
-		using Key = std::pair<std::string, size_t>;
-		static std::map<Key, uint64_t> memoized;
+	// Arrangements of each remaining suffix of a design. The keys point into
+	// the data, so a memo lasts for one part.
+	using SuffixMemo = Memo<std::string_view, uint64_t>;
 
-		if (pos == design.size())
+	static uint64_t countArrangements(const Data19& data, SuffixMemo& memo, std::string_view design)
+	{
+		if (design.empty())
 			return 1;
 
-		const Key key{design, pos};
-		auto memoIter = memoized.find(key);
-		if (memoIter != memoized.end())
-			return memoIter->second;
+		if (std::optional<uint64_t> count = memo.find(design))
+			return *count;
 
-		uint64_t numSolutions = 0;
+		uint64_t numArrangements = 0;
 
-		for (auto& towel : data.towels)
+		for (const std::string& towel : data.towels)
 		{
-			const size_t findPos = design.find(towel, pos);
-			if (findPos == pos)
-				numSolutions += solve(data, design, pos + towel.size());
+			if (design.starts_with(towel))
+				numArrangements += countArrangements(data, memo, design.substr(towel.size()));
 		}
 
-		memoized[key] = numSolutions;
-		return numSolutions;
+		memo.insert(design, numArrangements);
+		return numArrangements;
 	}
 
-	static uint64_t partOne(const Data19& data)
+	static SuffixMemo makeMemo()
 	{
-		uint64_t numPossible = 0;
+		return SuffixMemo({.numShards = 4 * Parallel::getThreadCount(), .name = "d19::countArrangements memo"});
+	}
 
-		for (const std::string& design : data.designs)
-			if (solve(data, design, 0))
-				numPossible++;
+	static uint64_t partOne(const Data19& data)
+	{
+		SuffixMemo memo = makeMemo();
 
-		return numPossible;
+		return Parallel::reduce(0, data.designs.size(), 0ull, [&] (size_t i)
+		{
+			return countArrangements(data, memo, data.designs[i]) ? 1ull : 0ull;
+		}, std::plus<>());
 	}
 
 	static uint64_t partTwo(const Data19& data)
 	{
-		uint64_t numSolutions = 0;
+		SuffixMemo memo = makeMemo();
 
-		for (const std::string& design : data.designs)
-			numSolutions += solve(data, design, 0);
-
-		return numSolutions;
+		return Parallel::reduce(0, data.designs.size(), 0ull, [&] (size_t i)
+		{
+			return countArrangements(data, memo, data.designs[i]);
+		}, std::plus<>());
 	}
 
 	static void processPrintAndAssert(const char* filename, auto expected1, auto expected2)
 	{
-		const auto data = loadData(filename);
-		const auto result1 = partOne(data);
-		const auto result2 = partTwo(data);
-
-		std::cout << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
-
-		assert(expected1 == decltype(expected1){} || result1 == expected1);
-		assert(expected2 == decltype(expected2){} || result2 == expected2);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected1, expected2);
 	}
 }
 
@@ -105,3 +108,5 @@ void day19()
 	d19::processPrintAndAssert("../data/19/test.txt", 6ull, 16ull);
 	d19::processPrintAndAssert("../data/19/real.txt", 293ull, 623924810770264ull);
 }
+
+static Days::Registrar registrar(19, day19, [] (const char* filename) { d19::processPrintAndAssert(filename, 0ull, 0ull); });
@@ -13,6 +13,9 @@
 #include <vector>
 #include <queue>
 
+#include "Grid.h"
+#include "Harness.h"
+#include "PathSearch.h"
 #include "String.h"
 #include "Renderer.h"
 #include "Vec2.h"
@@ -27,12 +30,17 @@ namespace d20
 		EZBounds bounds;
 	};
 
+	static void serialize(Cache::Archive& archive, Data20& data)
+	{
+		archive(data.walls, data.startPos, data.endPos, data.bounds);
+	}
+
 	static auto loadData(const char* filename)
 	{
 		Data20 data;
 
 		int y = 0;
-		for (const std::string& line : String::readLines(filename))
+		for (std::string_view line : String::Lines(filename))
 		{
 			for (int x = 0; x < (int) line.size(); ++x)
 			{
@@ -59,15 +67,16 @@ namespace d20
 
 	struct Grid
 	{
-		std::vector<std::vector<bool>> walls;
-		std::vector<std::vector<int>> distances;
+		::Grid<uint8_t> walls; // walled in, so that no step leaves the racetrack
+		::Grid<int> distances;
 		EZBounds bounds;
 
 		Grid(const Data20& data)
 			: bounds(data.bounds)
 		{
-			walls = std::vector<std::vector<bool>>(bounds.height, std::vector<bool>(bounds.width, false));
-			distances = std::vector<std::vector<int>>(bounds.height, std::vector<int>(bounds.width, 0));
+			constexpr int padding = 1;
+			walls = ::Grid<uint8_t>(bounds.width, bounds.height, false, padding, true);
+			distances = ::Grid<int>(bounds.width, bounds.height, 0, padding);
 
 			for (const Vec2& w : data.walls)
 				setWall(w);
@@ -75,22 +84,22 @@ namespace d20
 
 		void setWall(Vec2 pos)
 		{
-			walls[pos.y][pos.x] = true;
+			walls[pos] = true;
 		}
 
 		bool isWall(Vec2 pos) const
 		{
-			return walls[pos.y][pos.x];
+			return walls[pos];
 		}
 
 		void setScore(Vec2 pos, int score)
 		{
-			distances[pos.y][pos.x] = score;
+			distances[pos] = score;
 		}
 
 		int getScore(Vec2 pos) const
 		{
-			return distances[pos.y][pos.x];
+			return distances[pos];
 		}
 
 		void render(Renderer& renderer) const
@@ -100,7 +109,7 @@ namespace d20
 				for (int x = 0; x < bounds.width; ++x)
 				{
 					const Vec2 pos{x, y};
-					if (walls[y][x])
+					if (walls[pos])
 						renderer.plot(pos, '#');
 					else
 						renderer.plot(pos, '.');
@@ -109,97 +118,65 @@ namespace d20
 		}
 	};
 
-	struct Location
+	// Fills in the grid's distances from startPos, along the track as far as endPos.
+	static bool findDistances(Grid& grid, Vec2 startPos, Vec2 endPos)
 	{
-		Vec2 pos;
-		int score = 0;
+		const int width = grid.bounds.width;
+		auto index = [width] (Vec2 pos) { return (size_t) pos.y * width + pos.x; };
 
-		bool operator==(const Location& r) const { return pos == r.pos && score == r.score; }
-		bool operator!=(const Location& r) const { return !(*this == r); }
-		bool operator<(const Location& r) const { return pos < r.pos; } // for map
-	};
+		auto search = PathSearch::makeSearch<Vec2>((size_t) width * grid.bounds.height, index);
 
-	struct MoreExpensive
-	{
-		bool operator()(const Location& l, const Location& r) const
+		auto neighbours = [&] (Vec2 pos, auto&& visit)
 		{
-			return l.score > r.score;
-		}
-	};
+			for (Vec2 dir : Vec2::directions)
+				if (!grid.isWall(pos + dir))
+					visit(pos + dir, 1);
+		};
 
-	struct PathFinder
-	{
-		Location finalLocation;
+		auto isGoal = [&] (Vec2 pos) { return pos == endPos; };
 
-		bool pathFind(Grid& grid, Vec2 startPos, Vec2 endPos)
-		{
-			std::priority_queue<Location, std::vector<Location>, MoreExpensive> queue;
-
-			queue.push({startPos, 0});
-
-			std::set<Vec2> visited;
+		if (!search.run<PathSearch::Mode::BreadthFirst>(startPos, neighbours, isGoal))
+			return false;
 
-			while (!queue.empty())
+		for (int y = 0; y < grid.bounds.height; ++y)
+		{
+			for (int x = 0; x < grid.bounds.width; ++x)
 			{
-				const Location loc = queue.top();
-				queue.pop();
-
-				if (visited.insert(loc.pos).second)
-				{
-					assert(grid.getScore(loc.pos) == 0);
-					grid.setScore(loc.pos, loc.score);
-
-					if (loc.pos == endPos)
-					{
-						finalLocation = loc; // found end
-						return true;
-					}
-
-					// generate iterations
-					for (Vec2 dir : Vec2::directions)
-					{
-						const Location next = {loc.pos + dir, loc.score + 1};
-						if (grid.bounds.isInBounds(next.pos)
-							&& !grid.isWall(next.pos)
-							&& grid.getScore(next.pos) == 0)
-							queue.push(next);
-					}
-				}
+				const Vec2 pos{x, y};
+				if (search.isReached(pos))
+					grid.setScore(pos, search.getCost(pos));
 			}
-
-			return false;
 		}
-	};
+
+		return true;
+	}
 
 	static uint64_t partOne([[maybe_unused]] const Data20& data)
 	{
 		Grid grid(data);
-		PathFinder pathFinder;
-		const bool success = pathFinder.pathFind(grid, data.startPos, data.endPos);
+		const bool success = findDistances(grid, data.startPos, data.endPos);
 		assert(success);
 
 		uint64_t cheatsOver100 = 0;
-		std::map<int, int> cheatCounts;
 
 		for (Vec2 wallPos : data.walls)
 		{
 			for (int i = 0; i < (int) Direction::Count - 1; ++i)
 			{
 				const Vec2 n1 = wallPos + Vec2::directions[i];
-				if (!grid.bounds.isInBounds(n1) || grid.isWall(n1))
+				if (grid.isWall(n1))
 					continue;
 
 				for (int j = i + 1; j < (int) Direction::Count; ++j)
 				{
 					const Vec2 n2 = wallPos + Vec2::directions[j];
-					if (!grid.bounds.isInBounds(n2) || grid.isWall(n2))
+					if (grid.isWall(n2))
 						continue;
 
 					const int score1 = grid.getScore(n1);
 					const int score2 = grid.getScore(n2);
 					const int diff = abs(score1 - score2);
 					const int saving = diff - 2; // takes 2 picoseconds to cheat
-					cheatCounts[saving]++;
 					if (saving >= 100)
 						++cheatsOver100;
 				}
@@ -212,8 +189,7 @@ namespace d20
 	static uint64_t partTwo([[maybe_unused]] const Data20& data)
 	{
 		Grid grid(data);
-		PathFinder pathFinder;
-		const bool success = pathFinder.pathFind(grid, data.startPos, data.endPos);
+		const bool success = findDistances(grid, data.startPos, data.endPos);
 		assert(success);
 
 		uint64_t cheatsOver100 = 0;
@@ -262,14 +238,7 @@ namespace d20
 
 	static void processPrintAndAssert(const char* filename, auto expected1, auto expected2)
 	{
-		const auto data = loadData(filename);
-		const auto result1 = partOne(data);
-		const auto result2 = partTwo(data);
-
-		std::cout << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
-
-		assert(expected1 == decltype(expected1){} || result1 == expected1);
-		assert(expected2 == decltype(expected2){} || result2 == expected2);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected1, expected2);
 	}
 }
 
@@ -278,3 +247,5 @@ void day20()
 	d20::processPrintAndAssert("../data/20/test.txt", 0ull, 0ull);
 	d20::processPrintAndAssert("../data/20/real.txt", 1459ull, 1016066ull);
 }
+
+static Days::Registrar registrar(20, day20, [] (const char* filename) { d20::processPrintAndAssert(filename, 0ull, 0ull); });
@@ -9,9 +9,12 @@
 #include <ranges>
 #include <set>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
+#include "Harness.h"
+#include "Memo.h"
 #include "String.h"
 #include "Renderer.h"
 #include "Vec2.h"
@@ -24,6 +27,11 @@ namespace d21
 		std::vector<int> numeric;
 	};
 
+	static void serialize(Cache::Archive& archive, Data21& data)
+	{
+		archive(data.codes, data.numeric);
+	}
+
 	static auto loadData(const char* filename)
 	{
 		Data21 data;
@@ -84,15 +92,18 @@ namespace d21
 			return {-1,-1};
 		}
 
-		const std::vector<std::string>& getPermutations(const char from, const char to) const
+		std::vector<std::string> getPermutations(const char from, const char to) const
 		{
-			using Key = std::pair<char, char>;
-			static std::map<Key, std::vector<std::string>> memoized;
+			// The moves depend only on the keypad layout, so one table serves
+			// every run. The keypads share some buttons, so they key it too.
+			using Key = std::tuple<const std::vector<std::string>*, char, char>;
+			static Memo<Key, std::vector<std::string>> memoized({.name = "d21::getPermutations memo"});
 
-			const Key key{from, to};
-			if (auto iter = memoized.find(key); iter != memoized.end())
-				return iter->second;
+			return memoized.get({&keypad, from, to}, [&] { return calculatePermutations(from, to); });
+		}
 
+		std::vector<std::string> calculatePermutations(const char from, const char to) const
+		{
 			const Vec2 fromPos = getKeyPos(from);
 			const Vec2 toPos = getKeyPos(to);
 			const Vec2 deadPos = getKeyPos(' ');
@@ -117,7 +128,7 @@ namespace d21
 			permYFirst.append(abs(delta.x), buttonX);
 			permYFirst.push_back('A');
 
-			std::vector<std::string>& perms = memoized[key];
+			std::vector<std::string> perms;
 
 			if (fromPos + Vec2{delta.x, 0} == deadPos)
 			{
@@ -218,16 +229,25 @@ namespace d21
 		return complexitySum;
 	}
 
-	static void processPrintAndAssert(const char* filename, auto expected1, auto expected2)
+	// Fills the permutation table for every pair of buttons on both keypads.
+	static void warm()
 	{
-		const auto data = loadData(filename);
-		const auto result1 = partOne(data);
-		const auto result2 = partTwo(data);
-
-		std::cout << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
+		for (const std::vector<std::string>* keypad : {&numKeypad, &dirKeypad})
+		{
+			const Robot robot(*keypad);
+
+			for (const std::string& fromRow : *keypad)
+				for (const char from : fromRow)
+					for (const std::string& toRow : *keypad)
+						for (const char to : toRow)
+							if (from != ' ' && to != ' ')
+								robot.getPermutations(from, to);
+		}
+	}
 
-		assert(expected1 == decltype(expected1){} || result1 == expected1);
-		assert(expected2 == decltype(expected2){} || result2 == expected2);
+	static void processPrintAndAssert(const char* filename, auto expected1, auto expected2)
+	{
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected1, expected2);
 	}
 
 	void assertComplexity(
@@ -254,3 +274,5 @@ void day21()
 	d21::processPrintAndAssert("../data/21/test.txt", 126384ull, 154115708116294ull);
 	d21::processPrintAndAssert("../data/21/real.txt", 162740ull, 203640915832208ull);
 }
+
+static Days::Registrar registrar(21, day21, [] (const char* filename) { d21::processPrintAndAssert(filename, 0ull, 0ull); }, d21::warm);
@@ -12,6 +12,10 @@
 #include <unordered_map>
 #include <vector>
 
+#include "Harness.h"
+#include "MappedFile.h"
+#include "Parallel.h"
+#include "Stats.h"
 #include "String.h"
 #include "Renderer.h"
 #include "Vec2.h"
@@ -23,14 +27,19 @@ namespace d22
 		std::vector<uint64_t> secrets;
 	};
 
+	static void serialize(Cache::Archive& archive, Data22& data)
+	{
+		archive(data.secrets);
+	}
+
 	static auto loadData(const char* filename)
 	{
 		Data22 data;
 
-		for (std::string& line : String::readLines(filename))
-		{
-			data.secrets.push_back(std::stoull(line));
-		}
+		const MappedFile file(filename);
+		assert(file.isOpen());
+
+		String::parseInts({file.data(), file.size()}, data.secrets);
 
 		return data;
 	}
@@ -68,122 +77,128 @@ namespace d22
 
 	static uint64_t partOne(const Data22& data)
 	{
-		uint64_t sum = 0;
-
-		for (uint64_t s : data.secrets)
+		return Parallel::reduce(0, data.secrets.size(), 0ull, [&] (size_t buyer)
 		{
+			uint64_t s = data.secrets[buyer];
 			for (int i = 0; i < 2000; ++i)
 				s = prng(s);
 
-			sum += s;
-		}
-
-		return sum;
+			return s;
+		}, std::plus<>());
 	}
 	
-	using Sequence = std::tuple<int, int, int, int>;
+	// Four changes of -9 to 9 give 19^4 sequences.
+	constexpr int numSequences = 19 * 19 * 19 * 19;
 
-	struct Buyer
+	// Rather than keep every buyer's sequences, adds each buyer's price for a
+	// sequence the first time the buyer sees it into a running total per
+	// sequence.
+	struct SequenceSales
 	{
-		std::vector<int> prices;
-		std::vector<int> diffs;
-
-		std::map<Sequence, int> pricesPerSequence;
+		std::vector<uint64_t> salesPerSequence = std::vector<uint64_t>(numSequences);
+		std::vector<uint32_t> lastBuyerPerSequence = std::vector<uint32_t>(numSequences);
+		uint32_t numBuyers = 0;
 
-		explicit Buyer(uint64_t s, int count = 2000)
+		// Returns the buyer's last secret.
+		uint64_t addBuyer(uint64_t s)
 		{
+			const uint32_t buyer = ++numBuyers;
 			int last = (int) (s % 10);
-			prices.push_back(last);
+			int sequence = 0;
 
-			for (int i = 0; i < count; ++i)
+			for (int i = 0; i < 2000; ++i)
 			{
 				s = prng(s);
 
 				const int price = (int) (s % 10);
-
-				prices.push_back(price);
-				diffs.push_back(price - last);
+				sequence = (sequence * 19 + (price - last + 9)) % numSequences;
 				last = price;
-			}
 
-			for (size_t i = 3; i < diffs.size(); ++i)
-			{
-				Sequence key =
+				if (i >= 3 && lastBuyerPerSequence[sequence] != buyer)
 				{
-					diffs[i-3],
-					diffs[i-2], 
-					diffs[i-1], 
-					diffs[i-0], 
-				};
-
-				pricesPerSequence.insert({key, prices[i+1]});
+					lastBuyerPerSequence[sequence] = buyer;
+					salesPerSequence[sequence] += price;
+				}
 			}
+
+			return s;
 		}
-	};
 
-	uint64_t calculateSalesForSequence(const Sequence& sequence, const std::vector<Buyer>& buyers)
-	{
-		uint64_t sales = 0;
-		
-		for (const Buyer& buyer : buyers)
+		SequenceSales& operator+=(const SequenceSales& other)
 		{
-			const auto& b2Iter = buyer.pricesPerSequence.find(sequence);
-			if (b2Iter != buyer.pricesPerSequence.end())
-				sales += b2Iter->second;
+			for (int i = 0; i < numSequences; ++i)
+				salesPerSequence[i] += other.salesPerSequence[i];
+
+			return *this;
 		}
 
-		return sales;
-	}
+		uint64_t getBestSale() const
+		{
+			return *std::max_element(salesPerSequence.begin(), salesPerSequence.end());
+		}
+	};
 
 	void unittest_sequence()
 	{
-		std::vector<Buyer> buyers =
-		{
-			Buyer(1),
-			Buyer(2),
-			Buyer(3),
-			Buyer(2024)
-		};
+		SequenceSales sales;
+		for (uint64_t s : {1, 2, 3, 2024})
+			sales.addBuyer(s);
 
-		assert(calculateSalesForSequence({-2,1,-1,3}, buyers) == 23ull);
+		// The best sequence is -2,1,-1,3.
+		assert(sales.getBestSale() == 23ull);
 	}
 
 	static uint64_t partTwo(const Data22& data)
 	{
-		std::vector<Buyer> buyers;
-
-		for (uint64_t s : data.secrets)
-			buyers.emplace_back(s);
+		STATS_SCOPED_TIMER("d22::partTwo");
 
-		uint64_t bestSale = 0;
-		std::set<Sequence> seen;
+		// Enough buyers per chunk to be worth a chunk's tables.
+		constexpr size_t minChunkSize = 64;
 
-		for (const Buyer& b1 : buyers)
+		const SequenceSales sales = Parallel::reduceChunks(0, data.secrets.size(), SequenceSales(), [&] (size_t begin, size_t end)
 		{
-			for (const auto& iter : b1.pricesPerSequence)
-			{
-				const Sequence& seq = iter.first;
-				if (!seen.insert(seq).second)
-					continue;
+			SequenceSales chunkSales;
+			for (size_t i = begin; i < end; ++i)
+				chunkSales.addBuyer(data.secrets[i]);
 
-				const uint64_t sales = calculateSalesForSequence(seq, buyers);
-				bestSale = std::max(bestSale, sales);
-			}
-		}
+			return chunkSales;
+		},
+		[] (SequenceSales total, SequenceSales chunkSales)
+		{
+			total += chunkSales;
+			return total;
+		},
+		minChunkSize);
 
-		return bestSale;
+		return sales.getBestSale();
 	}
 
-	static void processPrintAndAssert(const char* filename, auto expected1, auto expected2)
+	// Streams the buyers one at a time.
+	struct Reducer
 	{
-		const auto data = loadData(filename);
-		const auto result1 = partOne(data);
-		const auto result2 = partTwo(data);
+		SequenceSales sales;
+		std::vector<uint64_t> secrets;
+		uint64_t sumOfSecrets = 0;
 
-		std::cout << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
+		void add(std::string_view line)
+		{
+			secrets.clear();
+			String::parseInts(line, secrets);
 
-		assert(expected1 == decltype(expected1){} || result1 == expected1);
-		assert(expected2 == decltype(expected2){} || result2 == expected2);
+			for (uint64_t s : secrets)
+				sumOfSecrets += sales.addBuyer(s);
+		}
+
+		uint64_t partOne() const { return sumOfSecrets; }
+		uint64_t partTwo() const { return sales.getBestSale(); }
+	};
+
+	static void processPrintAndAssert(const char* filename, auto expected1, auto expected2)
+	{
+		if (Stream::isEnabled())
+			Harness::streamPrintAndAssert<Reducer>(filename, expected1, expected2);
+		else
+			Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected1, expected2);
 	}
 }
 
@@ -194,3 +209,5 @@ void day22()
 	d22::processPrintAndAssert("../data/22/test.txt", 37327623ull, 24ull);
 	d22::processPrintAndAssert("../data/22/real.txt", 17965282217ull, 2152ull);
 }
+
+static Days::Registrar registrar(22, day22, [] (const char* filename) { d22::processPrintAndAssert(filename, 0ull, 0ull); });
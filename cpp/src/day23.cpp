@@ -12,6 +12,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "Harness.h"
 #include "String.h"
 #include "Renderer.h"
 #include "Vec2.h"
@@ -26,11 +27,16 @@ namespace d23
 		std::vector<Connection> connections;
 	};
 
+	static void serialize(Cache::Archive& archive, Data23& data)
+	{
+		archive(data.connections);
+	}
+
 	static auto loadData(const char* filename)
 	{
 		Data23 data;
 
-		for (std::string& line : String::readLines(filename))
+		for (std::string_view line : String::Lines(filename))
 		{
 			auto pcs = String::delimit(line, '-');
 			data.connections.emplace_back(pcs[0], pcs[1]);
@@ -152,14 +158,7 @@ namespace d23
 
 	static void processPrintAndAssert(const char* filename, auto expected1, auto expected2)
 	{
-		const auto data = loadData(filename);
-		const auto result1 = partOne(data);
-		const auto result2 = partTwo(data);
-
-		std::cout << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
-
-		assert(expected1 == decltype(expected1){} || result1 == expected1);
-		assert(expected2 == decltype(expected2){} || result2 == expected2);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected1, expected2);
 	}
 }
 
@@ -168,3 +167,5 @@ void day23()
 	d23::processPrintAndAssert("../data/23/test.txt", 7ull, "co,de,ka,ta");
 	d23::processPrintAndAssert("../data/23/real.txt", 1308ull, "bu,fq,fz,pn,rr,st,sv,tr,un,uy,zf,zi,zy");
 }
+
+static Days::Registrar registrar(23, day23, [] (const char* filename) { d23::processPrintAndAssert(filename, 0ull, std::string()); });
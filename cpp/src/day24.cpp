@@ -12,6 +12,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "Days.h"
+#include "Harness.h"
 #include "String.h"
 #include "Renderer.h"
 #include "Vec2.h"
@@ -33,6 +35,11 @@ namespace d24
 		Operator op = Operator::AND;
 	};
 
+	static void serialize(Cache::Archive& archive, GateData& gate)
+	{
+		archive(gate.input1, gate.input2, gate.output, gate.op);
+	}
+
 	struct Data24
 	{
 		std::set<std::string> wireIds;
@@ -40,13 +47,19 @@ namespace d24
 		std::vector<GateData> gates;
 	};
 
+	static void serialize(Cache::Archive& archive, Data24& data)
+	{
+		archive(data.wireIds, data.wireValues, data.gates);
+	}
+
 	static auto loadData(const char* filename)
 	{
 		Data24 data;
 
 		bool parseWires = true;
+		std::vector<std::string_view> parts;
 
-		for (const std::string& line : String::readLines(filename))
+		for (std::string_view line : String::Lines(filename))
 		{
 			if (line.empty())
 			{
@@ -54,15 +67,15 @@ namespace d24
 			}
 			else if (parseWires)
 			{
-				auto parts = String::delimit(line, ": ");
+				String::tokenize(line, ": ", parts);
 				assert(parts.size() == 2);
 				assert(parts[1].size() == 1);
-				data.wireIds.insert(parts[0]);
-				data.wireValues[parts[0]] = (parts[1][0] == '1');
+				data.wireIds.emplace(parts[0]);
+				data.wireValues[std::string(parts[0])] = (parts[1][0] == '1');
 			}
 			else
 			{
-				auto parts = String::delimit(line, ' ');
+				String::tokenize(line, " ", parts);
 				assert(parts.size() == 5);
 
 				GateData g;
@@ -336,7 +349,7 @@ namespace d24
 					{
 						if (gate->output != bitGate.outputZ)
 						{
-							std::cout << "Error at " << i << " (inXOR gate has wrong output)"
+							Days::out() << "Error at " << i << " (inXOR gate has wrong output)"
 								<< ": gate->output: " << gate->output->id
 								<< ", bitGate.outputZ: " << bitGate.outputZ->id
 								<< std::endl;
@@ -374,7 +387,7 @@ namespace d24
 				{
 					if (otherInput != prevCarry)
 					{
-						std::cout << "Error at " << i << " (carryXOR wrong prevCarry (wrong output on prev carryORGate))"
+						Days::out() << "Error at " << i << " (carryXOR wrong prevCarry (wrong output on prev carryORGate))"
 							<< ": prevCarry: " << (prevCarry ? prevCarry->id : "null")
 							<< ", bufferZ: " << bitGate.bufferZ->id
 							<< ", otherInput: " << otherInput->id
@@ -383,7 +396,7 @@ namespace d24
 
 					if (gate->output != bitGate.outputZ)
 					{
-						std::cout << "Error at " << i << " (carryXOR gate has wrong output)"
+						Days::out() << "Error at " << i << " (carryXOR gate has wrong output)"
 							<< ": gate->output: " << gate->output->id
 							<< ", bitGate.outputZ: " << bitGate.outputZ->id
 							<< std::endl;
@@ -395,7 +408,7 @@ namespace d24
 				{
 					if (otherInput != prevCarry)
 					{
-						std::cout << "Error at " << i << " (carryAND wrong prevCarry (wrong output on prev carryORGate))"
+						Days::out() << "Error at " << i << " (carryAND wrong prevCarry (wrong output on prev carryORGate))"
 							<< ": prevCarry: " << (prevCarry ? prevCarry->id : "null")
 							<< ", bufferZ: " << bitGate.bufferZ->id
 							<< ", otherInput: " << otherInput->id
@@ -407,7 +420,7 @@ namespace d24
 				}
 				else
 				{
-					std::cout << "Error at " << i << " (OR wrong prevCarry (wrong output on prev inORGate))"
+					Days::out() << "Error at " << i << " (OR wrong prevCarry (wrong output on prev inORGate))"
 						<< ": prevCarry: " << (prevCarry ? prevCarry->id : "null")
 						<< std::endl;
 				}
@@ -415,28 +428,28 @@ namespace d24
 
 			if (bitGate.bufferC1 && bitGate.bufferC1->to.size() == 0)
 			{
-				std::cout << "Error at " << i << " (no outputs on bufferC1 - wrong output on inAND gate)"
+				Days::out() << "Error at " << i << " (no outputs on bufferC1 - wrong output on inAND gate)"
 					<< ": bufferC1: " << bitGate.bufferC1->id
 					<< std::endl;
 			}
 
 			if (bitGate.bufferC1 && bitGate.bufferC1->to.size() > 1)
 			{
-				std::cout << "Error at " << i << " (too many outputs on bufferC1 - wrong output on inAND gate)"
+				Days::out() << "Error at " << i << " (too many outputs on bufferC1 - wrong output on inAND gate)"
 					<< ": bufferC1: " << bitGate.bufferC1->id
 					<< std::endl;
 			}
 
 			if (bitGate.bufferC2 && bitGate.bufferC2->to.size() == 0)
 			{
-				std::cout << "Error at " << i << " (no outputs on bufferC2 - wrong output on carryAND gate)"
+				Days::out() << "Error at " << i << " (no outputs on bufferC2 - wrong output on carryAND gate)"
 					<< ": bufferC2: " << bitGate.bufferC2->id
 					<< std::endl;
 			}
 
 			if (bitGate.bufferC2 && bitGate.bufferC2->to.size() > 1)
 			{
-				std::cout << "Error at " << i << " (too many outputs on bufferC2 - wrong output on carryAND gate)"
+				Days::out() << "Error at " << i << " (too many outputs on bufferC2 - wrong output on carryAND gate)"
 					<< ": bufferC2: " << bitGate.bufferC2->id
 					<< std::endl;
 			}
@@ -447,7 +460,7 @@ namespace d24
 				Wire* otherWire = outC->getOtherInput(bitGate.bufferC1);
 				if (otherWire != bitGate.bufferC2)
 				{
-					std::cout << "Error at " << i << " (carryOR has wrong inputs - wrong output bufferC1 or bufferC2 (inAND or carryAND)"
+					Days::out() << "Error at " << i << " (carryOR has wrong inputs - wrong output bufferC1 or bufferC2 (inAND or carryAND)"
 						<< ": bufferC2: " << bitGate.bufferC2->id
 						<< std::endl;
 				}
@@ -458,18 +471,18 @@ namespace d24
 		}
 
 		// summary?
-		std::cout << "Summary Report of Incorrect Outputs" << std::endl;
+		Days::out() << "Summary Report of Incorrect Outputs" << std::endl;
 
 		for (BitGate& gate : bitGates)
 		{
 			if (gate.bitIndex == 0)
 			{
 				if (gate.inXORGate->output != gate.outputZ)
-					std::cout << "Gate " << gate.bitIndex << " inXOR, wire: " << gate.inXORGate->output->id << std::endl;
+					Days::out() << "Gate " << gate.bitIndex << " inXOR, wire: " << gate.inXORGate->output->id << std::endl;
 
 				Wire* carry = gate.inANDGate->output;
 				if (carry->to.size() != 2)
-					std::cout << "Gate " << gate.bitIndex << " inAND, wire: " << gate.inANDGate->output->id << std::endl;
+					Days::out() << "Gate " << gate.bitIndex << " inAND, wire: " << gate.inANDGate->output->id << std::endl;
 				else
 				{
 					for (Gate* carryGate : carry->to)
@@ -477,7 +490,7 @@ namespace d24
 						if (carryGate->op == Operator::XOR)
 						{
 							if (carryGate->output != network.getWire('z', gate.bitIndex + 1))
-								std::cout << "Gate " << gate.bitIndex << " inAND, wire: " << gate.inANDGate->output->id
+								Days::out() << "Gate " << gate.bitIndex << " inAND, wire: " << gate.inANDGate->output->id
 								<< "or gate " << gate.bitIndex + 1 << " carryXOR, wire: " << carryGate->output->id << std::endl;
 						}
 					}
@@ -487,19 +500,19 @@ namespace d24
 			{
 				auto isZOutput = [] (Wire* w) { return w->id.front() == 'z'; }; 
 				if (gate.inXORGate && isZOutput(gate.inXORGate->output))
-					std::cout << "Gate " << gate.bitIndex << " inXOR, wire: " << gate.inXORGate->output->id << std::endl;
+					Days::out() << "Gate " << gate.bitIndex << " inXOR, wire: " << gate.inXORGate->output->id << std::endl;
 
 				if (gate.inANDGate && isZOutput(gate.inANDGate->output))
-					std::cout << "Gate " << gate.bitIndex << " inAND, wire: " << gate.inANDGate->output->id << std::endl;
+					Days::out() << "Gate " << gate.bitIndex << " inAND, wire: " << gate.inANDGate->output->id << std::endl;
 
 				if (gate.carryXORGate && !isZOutput(gate.carryXORGate->output))
-					std::cout << "Gate " << gate.bitIndex << " carryXOR, wire: " << gate.carryXORGate->output->id << std::endl;
+					Days::out() << "Gate " << gate.bitIndex << " carryXOR, wire: " << gate.carryXORGate->output->id << std::endl;
 
 				if (gate.carryANDGate && isZOutput(gate.carryANDGate->output))
-					std::cout << "Gate " << gate.bitIndex << " carryAND, wire: " << gate.carryANDGate->output->id << std::endl;
+					Days::out() << "Gate " << gate.bitIndex << " carryAND, wire: " << gate.carryANDGate->output->id << std::endl;
 
 				if (gate.carryORGate && isZOutput(gate.carryORGate->output))
-					std::cout << "Gate " << gate.bitIndex << " carryOR, wire: " << gate.carryORGate->output->id << std::endl;
+					Days::out() << "Gate " << gate.bitIndex << " carryOR, wire: " << gate.carryORGate->output->id << std::endl;
 
 			}
 		}
@@ -510,14 +523,9 @@ namespace d24
 
 	static void processPrintAndAssert(const char* filename, auto expected1, std::optional<std::string> expected2)
 	{
-		const auto data = loadData(filename);
-		const auto result1 = partOne(data);
-		const auto result2 = expected2 ? partTwo(data) : std::string();
+		const auto partTwoIfExpected = [&] (const Data24& data) { return expected2 ? partTwo(data) : std::string(); };
 
-		std::cout << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
-
-		assert(expected1 == decltype(expected1){} || result1 == expected1);
-		assert(!expected2 || expected2.value() == "" || result2 == expected2.value());
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwoIfExpected, expected1, expected2.value_or(""));
 	}
 }
 
@@ -527,3 +535,5 @@ void day24()
 	d24::processPrintAndAssert("../data/24/test2.txt", 2024ull, {});
 	d24::processPrintAndAssert("../data/24/real.txt", 61886126253040ull, "fgt,fpq,nqk,pcp,srn,z07,z24,z32");
 }
+
+static Days::Registrar registrar(24, day24, [] (const char* filename) { d24::processPrintAndAssert(filename, 0ull, std::string()); });
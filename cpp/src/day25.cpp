@@ -13,6 +13,7 @@
 #include <vector>
 #include <array>
 
+#include "Harness.h"
 #include "String.h"
 #include "Renderer.h"
 #include "Vec2.h"
@@ -46,6 +47,11 @@ namespace d25
 		std::vector<KeyOrLock> locks;
 	};
 
+	static void serialize(Cache::Archive& archive, Data25& data)
+	{
+		archive(data.keys, data.locks);
+	}
+
 	static auto loadData(const char* filename)
 	{
 		Data25 data;
@@ -53,7 +59,7 @@ namespace d25
 		std::vector<std::vector<std::string>> groups;
 		std::vector<std::string>* currentGroup = nullptr;
 
-		for (const std::string& line : String::readLines(filename))
+		for (std::string_view line : String::Lines(filename))
 		{
 			if (line.empty())
 			{
@@ -66,7 +72,7 @@ namespace d25
 				currentGroup = &groups.back();
 			}
 
-			currentGroup->push_back(line);
+			currentGroup->emplace_back(line);
 		}
 
 		for (auto& group : groups)
@@ -116,14 +122,7 @@ namespace d25
 
 	static void processPrintAndAssert(const char* filename, auto expected1, auto expected2)
 	{
-		const auto data = loadData(filename);
-		const auto result1 = partOne(data);
-		const auto result2 = partTwo(data);
-
-		std::cout << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
-
-		assert(expected1 == decltype(expected1){} || result1 == expected1);
-		assert(expected2 == decltype(expected2){} || result2 == expected2);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected1, expected2);
 	}
 }
 
@@ -132,3 +131,5 @@ void day25()
 	d25::processPrintAndAssert("../data/25/test.txt", 3ull, 0ull);
 	d25::processPrintAndAssert("../data/25/real.txt", 3508ull, 0ull);
 }
+
+static Days::Registrar registrar(25, day25, [] (const char* filename) { d25::processPrintAndAssert(filename, 0ull, 0ull); });
@@ -1,9 +1,349 @@
-#define currentday day25
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
 
-int main()
+#include "Batch.h"
+#include "Cache.h"
+#include "Days.h"
+#include "Generators.h"
+#include "Harness.h"
+#include "Parallel.h"
+#include "Perf.h"
+#include "Recording.h"
+#include "Renderer.h"
+#include "Service.h"
+#include "Stream.h"
+#include "String.h"
+
+static void printUsage(const char* exe)
+{
+	std::cerr
+		<< "Usage: " << exe << " [options] [day | first-last | all]...\n"
+		<< "  Runs the given days (all registered days if none are given).\n"
+		<< "  -j threads      Number of days to run at once (default: one per core).\n"
+		<< "  --threads n     Number of threads each day's parallel loops may use (default: one per core).\n"
+		<< "  --bench [runs]  Time each load/part phase over repeated runs (default: 10).\n"
+		<< "                  Days run one at a time unless -j is given.\n"
+		<< "  --warmup runs   Untimed runs before measuring (default: 2).\n"
+		<< "  --json file     Write benchmark results to file as JSON.\n"
+		<< "  --cache         Load parsed input from a binary cache next to each input file,\n"
+		<< "                  writing it on first use.\n"
+		<< "  --stream [KiB]  Days that reduce over independent lines read their input in chunks\n"
+		<< "                  of this size (default: 1024) instead of loading it all.\n"
+		<< "  --perf          Count cycles, instructions and cache/branch misses per phase (Linux).\n"
+		<< "  --generate day size file\n"
+		<< "                  Write a random input for the day at the given size, then exit.\n"
+		<< "  --sweep day size,size,...\n"
+		<< "                  Benchmark the day on generated inputs of each size and show how it scales.\n"
+		<< "  --seed n        Seed for --generate and --sweep (default: 1).\n"
+		<< "  --record dir    Save rendered frames under dir instead of drawing them (needs AOC_RENDER).\n"
+		<< "  --batch day inputs\n"
+		<< "                  Solve the day for every file in the inputs directory (or listed in the\n"
+		<< "                  inputs manifest, one per line) across all threads, then exit.\n"
+		<< "  --serve [socket]\n"
+		<< "                  Stay resident and solve \"<day> <input file>\" requests read from stdin,\n"
+		<< "                  or from connections to a Unix domain socket at the given path.\n"
+		<< "  --timeout s     Seconds a --serve or --batch input may take before it is abandoned\n"
+		<< "                  (default: 60, 0 = no limit).\n"
+		<< "  --play file [fps]\n"
+		<< "                  Replay a recording at fps frames a second (default: 60, 0 = unthrottled), then exit." << std::endl;
+}
+
+// Parses the whole of arg as a number in [min, max].
+template <typename T>
+static bool parseNumber(std::string_view arg, T& value, T min = std::numeric_limits<T>::lowest(), T max = std::numeric_limits<T>::max())
+{
+	T parsed = 0;
+	const auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), parsed);
+	if (error != std::errc() || end != arg.data() + arg.size() || parsed < min || parsed > max)
+		return false;
+
+	value = parsed;
+	return true;
+}
+
+// Parses "day" or "first-last", both ends required and in order.
+static bool parseDayRange(std::string_view arg, int& first, int& last)
+{
+	const size_t dash = arg.find('-');
+	if (dash == std::string_view::npos)
+	{
+		if (!parseNumber(arg, first, 1))
+			return false;
+
+		last = first;
+		return true;
+	}
+
+	return parseNumber(arg.substr(0, dash), first, 1) && parseNumber(arg.substr(dash + 1), last, 1) && first <= last;
+}
+
+static int rejectValue(const char* exe, const std::string& option, const char* value)
 {
-	extern void currentday();
-	currentday();
+	std::cerr << "Bad value \"" << value << "\" for " << option << std::endl;
+	printUsage(exe);
+	return 1;
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<int> dayNumbers;
+	unsigned threadCount = 0;
+	bool threadCountGiven = false;
+	Harness::BenchmarkOptions benchmarkOptions;
+	const char* jsonFilename = nullptr;
+
+	int generateDay = 0;
+	uint64_t generateSize = 0;
+	const char* generateFilename = nullptr;
+	int sweepDay = 0;
+	std::vector<uint64_t> sweepSizes;
+	uint64_t seed = 1;
+	const char* playFilename = nullptr;
+	double playFramesPerSecond = 60.0;
+	int batchDay = 0;
+	const char* batchInputs = nullptr;
+	bool serve = false;
+	const char* serveSocket = nullptr;
+
+	auto isNumber = [] (const char* arg) { return std::isdigit((unsigned char) arg[0]) != 0; };
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+
+		if (arg == "-j" && i + 1 < argc)
+		{
+			if (!parseNumber(argv[++i], threadCount))
+				return rejectValue(argv[0], arg, argv[i]);
+
+			threadCountGiven = true;
+		}
+		else if (arg == "--threads" && i + 1 < argc)
+		{
+			unsigned count = 0;
+			if (!parseNumber(argv[++i], count))
+				return rejectValue(argv[0], arg, argv[i]);
+
+			Parallel::setThreadCount(count);
+		}
+		else if (arg == "--bench")
+		{
+			benchmarkOptions.enabled = true;
+			if (i + 1 < argc && isNumber(argv[i + 1]))
+			{
+				if (!parseNumber(argv[++i], benchmarkOptions.measuredRuns, 0))
+					return rejectValue(argv[0], arg, argv[i]);
+
+				benchmarkOptions.measuredRuns = std::max(1, benchmarkOptions.measuredRuns);
+			}
+		}
+		else if (arg == "--warmup" && i + 1 < argc)
+		{
+			if (!parseNumber(argv[++i], benchmarkOptions.warmupRuns, 0))
+				return rejectValue(argv[0], arg, argv[i]);
+		}
+		else if (arg == "--json" && i + 1 < argc)
+		{
+			jsonFilename = argv[++i];
+		}
+		else if (arg == "--cache")
+		{
+			Cache::setEnabled(true);
+		}
+		else if (arg == "--stream")
+		{
+			Stream::setEnabled(true);
+			if (i + 1 < argc && isNumber(argv[i + 1]))
+			{
+				size_t kibibytes = 0;
+				if (!parseNumber(argv[++i], kibibytes, size_t(0), std::numeric_limits<size_t>::max() / 1024))
+					return rejectValue(argv[0], arg, argv[i]);
+
+				Stream::setChunkSize(std::max<size_t>(1, kibibytes) * 1024);
+			}
+		}
+		else if (arg == "--perf")
+		{
+			Perf::setEnabled(true);
+		}
+		else if (arg == "--generate" && i + 3 < argc)
+		{
+			if (!parseNumber(argv[++i], generateDay, 1))
+				return rejectValue(argv[0], arg, argv[i]);
+
+			if (!parseNumber(argv[++i], generateSize))
+				return rejectValue(argv[0], arg, argv[i]);
+
+			generateFilename = argv[++i];
+		}
+		else if (arg == "--sweep" && i + 2 < argc)
+		{
+			if (!parseNumber(argv[++i], sweepDay, 1))
+				return rejectValue(argv[0], arg, argv[i]);
+
+			for (const std::string& size : String::delimit(argv[++i], ','))
+			{
+				uint64_t sweepSize = 0;
+				if (!parseNumber(size, sweepSize))
+					return rejectValue(argv[0], arg, argv[i]);
+
+				sweepSizes.push_back(sweepSize);
+			}
+		}
+		else if (arg == "--seed" && i + 1 < argc)
+		{
+			if (!parseNumber(argv[++i], seed))
+				return rejectValue(argv[0], arg, argv[i]);
+		}
+		else if (arg == "--record" && i + 1 < argc)
+		{
+			const char* directory = argv[++i];
+			std::error_code error;
+			std::filesystem::create_directories(directory, error);
+			Recording::setDirectory(directory);
+
+			if (!Renderer::isEnabled)
+				std::cerr << "Nothing will be recorded: this build has no AOC_RENDER" << std::endl;
+		}
+		else if (arg == "--play" && i + 1 < argc)
+		{
+			playFilename = argv[++i];
+			if (i + 1 < argc && isNumber(argv[i + 1]) && !parseNumber(argv[++i], playFramesPerSecond, 0.0))
+				return rejectValue(argv[0], arg, argv[i]);
+		}
+		else if (arg == "--batch" && i + 2 < argc)
+		{
+			if (!parseNumber(argv[++i], batchDay, 1))
+				return rejectValue(argv[0], arg, argv[i]);
+
+			batchInputs = argv[++i];
+		}
+		else if (arg == "--serve")
+		{
+			serve = true;
+			if (i + 1 < argc && argv[i + 1][0] != '-')
+				serveSocket = argv[++i];
+		}
+		else if (arg == "--timeout" && i + 1 < argc)
+		{
+			double seconds = 0.0;
+			if (!parseNumber(argv[++i], seconds, 0.0))
+				return rejectValue(argv[0], arg, argv[i]);
+
+			Service::setTimeout(seconds);
+		}
+		else if (arg == "all")
+		{
+			for (const Days::Day& day : Days::getAll())
+				dayNumbers.push_back(day.number);
+		}
+		else if (isNumber(argv[i]))
+		{
+			int first = 0;
+			int last = 0;
+			if (!parseDayRange(arg, first, last))
+			{
+				std::cerr << "Bad day range \"" << arg << "\"" << std::endl;
+				printUsage(argv[0]);
+				return 1;
+			}
+
+			for (int n = first; n <= last; ++n)
+				dayNumbers.push_back(n);
+		}
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (generateFilename)
+	{
+		if (!Generators::generate(generateDay, generateSize, seed, generateFilename))
+		{
+			std::cerr << "Could not generate day " << generateDay << " into " << generateFilename << std::endl;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	if (playFilename)
+	{
+		if (!Recording::play(playFilename, playFramesPerSecond))
+		{
+			std::cerr << "Could not play " << playFilename << std::endl;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	if (batchInputs)
+	{
+		Harness::setBenchmarkOptions(benchmarkOptions);
+		return Batch::run(batchDay, batchInputs) ? 0 : 1;
+	}
+
+	if (serve)
+	{
+		Harness::setBenchmarkOptions(benchmarkOptions);
+
+		if (!serveSocket)
+		{
+			Service::serve(std::cin, std::cout);
+			return 0;
+		}
+
+		if (!Service::serveSocket(serveSocket))
+		{
+			std::cerr << "Could not listen on " << serveSocket << std::endl;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	if (dayNumbers.empty())
+		for (const Days::Day& day : Days::getAll())
+			dayNumbers.push_back(day.number);
+
+	if (benchmarkOptions.enabled && !threadCountGiven)
+		threadCount = 1; // days running side by side would skew each other's timings
+
+	Harness::setBenchmarkOptions(benchmarkOptions);
+
+	if (sweepDay != 0)
+	{
+		benchmarkOptions.enabled = true;
+		Harness::setBenchmarkOptions(benchmarkOptions);
+
+		const bool swept = Harness::sweep(sweepDay, sweepSizes, seed);
+		if (jsonFilename && !Harness::writeBenchmarkJson(jsonFilename))
+		{
+			std::cerr << "Could not write " << jsonFilename << std::endl;
+			return 1;
+		}
+
+		return swept ? 0 : 1;
+	}
+
+	const int numMissing = Days::run(dayNumbers, threadCount);
+
+	if (jsonFilename && !Harness::writeBenchmarkJson(jsonFilename))
+	{
+		std::cerr << "Could not write " << jsonFilename << std::endl;
+		return 1;
+	}
 
-	return 0;
+	return numMissing == 0 ? 0 : 1;
 }
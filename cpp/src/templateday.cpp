@@ -12,6 +12,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "Harness.h"
 #include "String.h"
 #include "Renderer.h"
 #include "Vec2.h"
@@ -22,11 +23,16 @@ namespace d_X_
 	{
 	};
 
+	// List Data_X_'s fields here for --cache.
+	static void serialize([[maybe_unused]] Cache::Archive& archive, [[maybe_unused]] Data_X_& data)
+	{
+	}
+
 	static auto loadData(const char* filename)
 	{
 		Data_X_ data;
 
-		for (std::string& line : String::readLines(filename))
+		for (std::string_view line : String::Lines(filename))
 		{
 			if (line.empty())
 				continue;
@@ -48,14 +54,7 @@ namespace d_X_
 
 	static void processPrintAndAssert(const char* filename, auto expected1, auto expected2)
 	{
-		const auto data = loadData(filename);
-		const auto result1 = partOne(data);
-		const auto result2 = partTwo(data);
-
-		std::cout << "Part 1: " << result1 << " Part 2: " << result2 << std::endl;
-
-		assert(expected1 == decltype(expected1){} || result1 == expected1);
-		assert(expected2 == decltype(expected2){} || result2 == expected2);
+		Harness::processPrintAndAssert(filename, loadData, partOne, partTwo, expected1, expected2);
 	}
 }
 
@@ -64,3 +63,6 @@ void day_X_()
 	d_X_::processPrintAndAssert("../data/_X_/test.txt", 0ull, 0ull);
 	d_X_::processPrintAndAssert("../data/_X_/real.txt", 0ull, 0ull);
 }
+
+// Uncomment once _X_ has been replaced with the day number.
+//static Days::Registrar registrar(_X_, day_X_, [] (const char* filename) { d_X_::processPrintAndAssert(filename, 0ull, 0ull); });